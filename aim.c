@@ -0,0 +1,41 @@
+// Alien Advance
+// Michael Ebens
+
+#include "aim.h"
+
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#include <graphics.h>
+
+static const Aim PROGMEM aim_table[AIM_DIRECTIONS] = AIM_TABLE;
+
+uint8_t aim_read(void)
+{
+  ADCSRA |= (1 << ADSC); // start conversion
+  while (ADCSRA & (1 << ADSC)); // wait until complete
+
+  // 0..1023 covers two turns, rounded to the nearest direction
+  return ((uint32_t) ADC * (2 * AIM_DIRECTIONS) + 511) / 1023 % AIM_DIRECTIONS;
+}
+
+void aim_get(uint8_t direction, Aim* aim)
+{
+  memcpy_P(aim, &aim_table[direction], sizeof(Aim));
+}
+
+void aim_draw(const Aim* aim, uint8_t x, uint8_t y)
+{
+  for (uint8_t i = 0; i < aim->line_pixels; i++)
+  {
+    int16_t px = x + aim->line[i][0];
+    int16_t py = y + aim->line[i][1];
+
+    // the border and status bar are left alone
+    if (px < 1 || px > 83 || py < 9 || py > 47) continue;
+
+    screen_buffer[(py >> 3) * LCD_X + px] |= 1 << (py & 7);
+  }
+}
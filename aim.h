@@ -0,0 +1,38 @@
+// Alien Advance
+// Michael Ebens
+
+// The player's aim, quantised to AIM_DIRECTIONS directions so that the
+// aim line, missile launch point and missile velocity all come from a
+// table in flash instead of cos() and sin() every frame. The table is
+// generated by tools/aim_table.c into aim_table.h.
+//
+// Offsets are relative to the player's centre. The pot covers two full
+// turns, as it did when the angle was worked out in radians.
+
+#ifndef AIM_H_
+#define AIM_H_
+
+#include <stdint.h>
+
+#include "aim_table.h"
+
+typedef struct aim {
+  int8_t line[AIM_LINE_PIXELS][2]; // pixel offsets of the aim line
+  uint8_t line_pixels;             // how many of line are used
+  int16_t launch_x, launch_y;      // missile spawn offset, 8.8
+  int16_t speed_x, speed_y;        // missile velocity, 8.8 pixels per second
+} Aim;
+
+// reads the pot (ADC1) and returns the direction it points in
+uint8_t aim_read(void);
+
+// copies a direction's entry out of flash
+void aim_get(uint8_t direction, Aim* aim);
+
+// sets the aim line's pixels around (x, y), clipped to the play area
+void aim_draw(const Aim* aim, uint8_t x, uint8_t y);
+
+// a direction in tenths of a degree, for the debug output
+#define AIM_DECIDEGREES(direction) ((uint16_t) ((uint32_t) (direction) * 3600 / AIM_DIRECTIONS))
+
+#endif /* AIM_H_ */
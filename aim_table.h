@@ -0,0 +1,81 @@
+// Alien Advance
+// Michael Ebens
+
+// Generated by tools/aim_table.c (make aim_table.h), do not edit.
+// Directions go clockwise on screen from pointing right.
+
+#ifndef AIM_TABLE_H_
+#define AIM_TABLE_H_
+
+#define AIM_DIRECTIONS 64
+#define AIM_LINE_PIXELS 7
+
+// { line pixels, pixel count, launch x, y (8.8), speed x, y (8.8 per second) }
+#define AIM_TABLE { \
+  { { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 } }, 7, 512, 0, 2560, 0 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 1 }, { 4, 1 }, { 5, 1 }, { 6, 1 } }, 7, 510, 50, 2548, 251 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 1 }, { 4, 1 }, { 5, 1 }, { 6, 1 } }, 7, 502, 100, 2511, 499 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, 1 }, { 3, 1 }, { 4, 1 }, { 5, 2 }, { 6, 2 } }, 7, 490, 149, 2450, 743 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, 1 }, { 3, 1 }, { 4, 1 }, { 5, 2 }, { 6, 2 } }, 7, 473, 196, 2365, 980 }, \
+  { { { 0, 0 }, { 1, 1 }, { 2, 1 }, { 3, 2 }, { 4, 2 }, { 5, 3 }, { 0, 0 } }, 6, 452, 241, 2258, 1207 }, \
+  { { { 0, 0 }, { 1, 1 }, { 2, 1 }, { 3, 2 }, { 4, 2 }, { 5, 3 }, { 0, 0 } }, 6, 426, 284, 2129, 1422 }, \
+  { { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 2 }, { 4, 3 }, { 5, 4 }, { 0, 0 } }, 6, 396, 325, 1979, 1624 }, \
+  { { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 }, { 4, 4 }, { 0, 0 }, { 0, 0 } }, 5, 362, 362, 1810, 1810 }, \
+  { { { 0, 0 }, { 1, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 5 }, { 0, 0 } }, 6, 325, 396, 1624, 1979 }, \
+  { { { 0, 0 }, { 0, 1 }, { 1, 2 }, { 2, 3 }, { 2, 4 }, { 3, 5 }, { 0, 0 } }, 6, 284, 426, 1422, 2129 }, \
+  { { { 0, 0 }, { 0, 1 }, { 1, 2 }, { 2, 3 }, { 2, 4 }, { 3, 5 }, { 0, 0 } }, 6, 241, 452, 1207, 2258 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 3 }, { 1, 4 }, { 1, 5 }, { 2, 6 } }, 7, 196, 473, 980, 2365 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 3 }, { 1, 4 }, { 1, 5 }, { 2, 6 } }, 7, 149, 490, 743, 2450 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 1, 6 } }, 7, 100, 502, 499, 2511 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 1, 6 } }, 7, 50, 510, 251, 2548 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 0, 6 } }, 7, 0, 512, 0, 2560 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { -1, 6 } }, 7, -50, 510, -251, 2548 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { -1, 6 } }, 7, -100, 502, -499, 2511 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { -1, 3 }, { -1, 4 }, { -1, 5 }, { -2, 6 } }, 7, -149, 490, -743, 2450 }, \
+  { { { 0, 0 }, { 0, 1 }, { 0, 2 }, { -1, 3 }, { -1, 4 }, { -1, 5 }, { -2, 6 } }, 7, -196, 473, -980, 2365 }, \
+  { { { 0, 0 }, { 0, 1 }, { -1, 2 }, { -2, 3 }, { -2, 4 }, { -3, 5 }, { 0, 0 } }, 6, -241, 452, -1207, 2258 }, \
+  { { { 0, 0 }, { 0, 1 }, { -1, 2 }, { -2, 3 }, { -2, 4 }, { -3, 5 }, { 0, 0 } }, 6, -284, 426, -1422, 2129 }, \
+  { { { 0, 0 }, { -1, 1 }, { -1, 2 }, { -2, 3 }, { -3, 4 }, { -4, 5 }, { 0, 0 } }, 6, -325, 396, -1624, 1979 }, \
+  { { { 0, 0 }, { -1, 1 }, { -2, 2 }, { -3, 3 }, { -4, 4 }, { 0, 0 }, { 0, 0 } }, 5, -362, 362, -1810, 1810 }, \
+  { { { 0, 0 }, { -1, 1 }, { -2, 2 }, { -3, 2 }, { -4, 3 }, { -5, 4 }, { 0, 0 } }, 6, -396, 325, -1979, 1624 }, \
+  { { { 0, 0 }, { -1, 1 }, { -2, 1 }, { -3, 2 }, { -4, 2 }, { -5, 3 }, { 0, 0 } }, 6, -426, 284, -2129, 1422 }, \
+  { { { 0, 0 }, { -1, 1 }, { -2, 1 }, { -3, 2 }, { -4, 2 }, { -5, 3 }, { 0, 0 } }, 6, -452, 241, -2258, 1207 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, 1 }, { -3, 1 }, { -4, 1 }, { -5, 2 }, { -6, 2 } }, 7, -473, 196, -2365, 980 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, 1 }, { -3, 1 }, { -4, 1 }, { -5, 2 }, { -6, 2 } }, 7, -490, 149, -2450, 743 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, 0 }, { -3, 1 }, { -4, 1 }, { -5, 1 }, { -6, 1 } }, 7, -502, 100, -2511, 499 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, 0 }, { -3, 1 }, { -4, 1 }, { -5, 1 }, { -6, 1 } }, 7, -510, 50, -2548, 251 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, 0 }, { -3, 0 }, { -4, 0 }, { -5, 0 }, { -6, 0 } }, 7, -512, 0, -2560, 0 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, 0 }, { -3, -1 }, { -4, -1 }, { -5, -1 }, { -6, -1 } }, 7, -510, -50, -2548, -251 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, 0 }, { -3, -1 }, { -4, -1 }, { -5, -1 }, { -6, -1 } }, 7, -502, -100, -2511, -499 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, -1 }, { -3, -1 }, { -4, -1 }, { -5, -2 }, { -6, -2 } }, 7, -490, -149, -2450, -743 }, \
+  { { { 0, 0 }, { -1, 0 }, { -2, -1 }, { -3, -1 }, { -4, -1 }, { -5, -2 }, { -6, -2 } }, 7, -473, -196, -2365, -980 }, \
+  { { { 0, 0 }, { -1, -1 }, { -2, -1 }, { -3, -2 }, { -4, -2 }, { -5, -3 }, { 0, 0 } }, 6, -452, -241, -2258, -1207 }, \
+  { { { 0, 0 }, { -1, -1 }, { -2, -1 }, { -3, -2 }, { -4, -2 }, { -5, -3 }, { 0, 0 } }, 6, -426, -284, -2129, -1422 }, \
+  { { { 0, 0 }, { -1, -1 }, { -2, -2 }, { -3, -2 }, { -4, -3 }, { -5, -4 }, { 0, 0 } }, 6, -396, -325, -1979, -1624 }, \
+  { { { 0, 0 }, { -1, -1 }, { -2, -2 }, { -3, -3 }, { -4, -4 }, { 0, 0 }, { 0, 0 } }, 5, -362, -362, -1810, -1810 }, \
+  { { { 0, 0 }, { -1, -1 }, { -1, -2 }, { -2, -3 }, { -3, -4 }, { -4, -5 }, { 0, 0 } }, 6, -325, -396, -1624, -1979 }, \
+  { { { 0, 0 }, { 0, -1 }, { -1, -2 }, { -2, -3 }, { -2, -4 }, { -3, -5 }, { 0, 0 } }, 6, -284, -426, -1422, -2129 }, \
+  { { { 0, 0 }, { 0, -1 }, { -1, -2 }, { -2, -3 }, { -2, -4 }, { -3, -5 }, { 0, 0 } }, 6, -241, -452, -1207, -2258 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { -1, -3 }, { -1, -4 }, { -1, -5 }, { -2, -6 } }, 7, -196, -473, -980, -2365 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { -1, -3 }, { -1, -4 }, { -1, -5 }, { -2, -6 } }, 7, -149, -490, -743, -2450 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { 0, -3 }, { 0, -4 }, { 0, -5 }, { -1, -6 } }, 7, -100, -502, -499, -2511 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { 0, -3 }, { 0, -4 }, { 0, -5 }, { -1, -6 } }, 7, -50, -510, -251, -2548 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { 0, -3 }, { 0, -4 }, { 0, -5 }, { 0, -6 } }, 7, 0, -512, 0, -2560 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { 0, -3 }, { 0, -4 }, { 0, -5 }, { 1, -6 } }, 7, 50, -510, 251, -2548 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { 0, -3 }, { 0, -4 }, { 0, -5 }, { 1, -6 } }, 7, 100, -502, 499, -2511 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { 1, -3 }, { 1, -4 }, { 1, -5 }, { 2, -6 } }, 7, 149, -490, 743, -2450 }, \
+  { { { 0, 0 }, { 0, -1 }, { 0, -2 }, { 1, -3 }, { 1, -4 }, { 1, -5 }, { 2, -6 } }, 7, 196, -473, 980, -2365 }, \
+  { { { 0, 0 }, { 0, -1 }, { 1, -2 }, { 2, -3 }, { 2, -4 }, { 3, -5 }, { 0, 0 } }, 6, 241, -452, 1207, -2258 }, \
+  { { { 0, 0 }, { 0, -1 }, { 1, -2 }, { 2, -3 }, { 2, -4 }, { 3, -5 }, { 0, 0 } }, 6, 284, -426, 1422, -2129 }, \
+  { { { 0, 0 }, { 1, -1 }, { 1, -2 }, { 2, -3 }, { 3, -4 }, { 4, -5 }, { 0, 0 } }, 6, 325, -396, 1624, -1979 }, \
+  { { { 0, 0 }, { 1, -1 }, { 2, -2 }, { 3, -3 }, { 4, -4 }, { 0, 0 }, { 0, 0 } }, 5, 362, -362, 1810, -1810 }, \
+  { { { 0, 0 }, { 1, -1 }, { 2, -2 }, { 3, -2 }, { 4, -3 }, { 5, -4 }, { 0, 0 } }, 6, 396, -325, 1979, -1624 }, \
+  { { { 0, 0 }, { 1, -1 }, { 2, -1 }, { 3, -2 }, { 4, -2 }, { 5, -3 }, { 0, 0 } }, 6, 426, -284, 2129, -1422 }, \
+  { { { 0, 0 }, { 1, -1 }, { 2, -1 }, { 3, -2 }, { 4, -2 }, { 5, -3 }, { 0, 0 } }, 6, 452, -241, 2258, -1207 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, -1 }, { 3, -1 }, { 4, -1 }, { 5, -2 }, { 6, -2 } }, 7, 473, -196, 2365, -980 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, -1 }, { 3, -1 }, { 4, -1 }, { 5, -2 }, { 6, -2 } }, 7, 490, -149, 2450, -743 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, -1 }, { 4, -1 }, { 5, -1 }, { 6, -1 } }, 7, 502, -100, 2511, -499 }, \
+  { { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, -1 }, { 4, -1 }, { 5, -1 }, { 6, -1 } }, 7, 510, -50, 2548, -251 } \
+}
+
+#endif /* AIM_TABLE_H_ */
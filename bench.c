@@ -0,0 +1,113 @@
+// Alien Advance
+// Michael Ebens
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include <avr/avr_mcu_section.h>
+
+#include <graphics.h>
+
+#include "bench.h"
+#include "format.h"
+#include "profile.h"
+
+#if ENABLE_BENCH
+
+#if !ENABLE_PROFILING
+#error "the bench reads the profiler, build it with ENABLE_PROFILING=1"
+#endif
+
+AVR_MCU(F_CPU, "atmega32u4");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+// the spans by name, in profile.h order
+static const char span_names[PROF_NUM_SLOTS][8] PROGMEM = {
+  "frame", "input", "game", "show", "mirror", "sprite", "aim", "enemies"
+};
+
+// console keys, one per frame, looping: wander about and keep firing
+static const char script[] PROGMEM = "d d d w w  a a a s s  d w d s  a a w w ";
+
+static uint8_t script_at = 0;
+static uint8_t key_given = 0;
+static uint16_t frames = 0;
+
+// worst case per span over the whole run (the debug report resets
+// profile_max every 0.5s)
+static uint32_t worst[PROF_NUM_SLOTS];
+
+void bench_write(const char* string)
+{
+  // simavr prints the console a line at a time, ending at '\r'
+  while (*string != '\0') GPIOR0 = *string++;
+  GPIOR0 = '\r';
+}
+
+void bench_write_P(const char* string)
+{
+  char c;
+  while ((c = pgm_read_byte(string++)) != '\0') GPIOR0 = c;
+  GPIOR0 = '\r';
+}
+
+uint8_t bench_keys(uint8_t* buff, uint8_t size)
+{
+  // console_poll() reads until nothing is left, so one key per poll
+  key_given = !key_given;
+  if (!key_given || !size) return 0;
+
+  buff[0] = pgm_read_byte(&script[script_at++]);
+  if (script_at == sizeof(script) - 1) script_at = 0;
+  return 1;
+}
+
+// name is in program memory
+static uint8_t report(const char* name, uint32_t cycles, uint32_t budget)
+{
+  char line[DEBUG_BUFF_SIZE];
+  char* end = fmt_str_P(line, PSTR("BENCH "));
+  end = fmt_str_P(end, name);
+  end = fmt_char(end, ' ');
+  end = fmt_uint(end, cycles, 0, ' ');
+  end = fmt_char(end, ' ');
+  end = fmt_uint(end, budget, 0, ' ');
+  if (cycles > budget) fmt_str_P(end, PSTR(" OVER"));
+
+  bench_write(line);
+  return cycles > budget;
+}
+
+void bench_frame(void)
+{
+  for (uint8_t i = 0; i < PROF_NUM_SLOTS; i++)
+  {
+    if (profile_max[i] > worst[i]) worst[i] = profile_max[i];
+  }
+
+  if (++frames < BENCH_FRAMES) return;
+
+  uint8_t failures = 0;
+
+  for (uint8_t i = 0; i < PROF_NUM_SLOTS; i++)
+  {
+    failures += report(span_names[i], worst[i], profile_budget(i));
+
+    // show_screen is LCD_BUFFER_SIZE lcd_write calls
+    if (i == PROF_SHOW)
+    {
+      failures += report(PSTR("lcd_write"), worst[i] / LCD_BUFFER_SIZE, profile_budget(i) / LCD_BUFFER_SIZE);
+    }
+  }
+
+  bench_write_P(failures ? PSTR("BENCH FAIL") : PSTR("BENCH PASS"));
+
+  // simavr exits when the CPU sleeps with interrupts off
+  cli();
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+  sleep_enable();
+  sleep_cpu();
+}
+
+#endif /* ENABLE_BENCH */
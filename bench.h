@@ -0,0 +1,38 @@
+// Alien Advance
+// Michael Ebens
+
+// Benchmark build of the game for simavr (make bench), so frame costs
+// can be measured cycle for cycle with no board attached. The simulator
+// has no USB host, so in this build the game skips the USB wait and
+// starts straight into a round with a fixed seed, the console keys
+// come from a looping script, and debug lines go to the simavr
+// console. After BENCH_FRAMES frames the worst cycle count of every
+// profiled span (profile.h) is printed against its budget,
+//
+//   BENCH span cycles budget [OVER]
+//
+// then BENCH PASS or BENCH FAIL, and the simulation ends.
+// tools/bench.sh turns that into an exit status.
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+
+#include "config.h"
+
+#if ENABLE_BENCH
+
+// one line on the simavr console
+void bench_write(const char* string);
+void bench_write_P(const char* string); // string in program memory
+
+// stands in for usb_serial_read() in console_input.c
+uint8_t bench_keys(uint8_t* buff, uint8_t size);
+
+// call at the end of every frame, ends the run after BENCH_FRAMES
+void bench_frame(void);
+
+#endif /* ENABLE_BENCH */
+
+#endif /* BENCH_H_ */
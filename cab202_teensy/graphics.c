@@ -106,3 +106,82 @@ void draw_string(unsigned char top_left_x, unsigned char top_left_y, char *chara
 		i++;
 	}
 }
+
+void draw_string_P(unsigned char top_left_x, unsigned char top_left_y, const char *characters) {
+	unsigned char i = 0;
+	char character;
+
+	// Same as draw_string, reading the string from program memory
+	while ((character = pgm_read_byte(characters)) != 0) {
+		draw_char(top_left_x+i*5, top_left_y, character);
+
+		characters++;
+		i++;
+	}
+}
+
+#define RECT_FILL 0
+#define RECT_CLEAR 1
+#define RECT_INVERT 2
+
+static void rect_op(unsigned char top_left_x, unsigned char top_left_y, unsigned char width, unsigned char height, unsigned char op) {
+	// Coordinates wrap at 256, the same as drawing pixel by pixel with
+	// unsigned char coordinates, so a rectangle starting left of or
+	// above the screen (a "negative" x or y) shows its far part.
+	// Do the part past the wrap on its own.
+	if (width == 0 || height == 0) {
+		return;
+	}
+	if (top_left_x + width > 256) {
+		rect_op(0, top_left_y, top_left_x + width - 256, height, op);
+		width = 256 - top_left_x;
+	}
+	if (top_left_y + height > 256) {
+		rect_op(top_left_x, 0, width, top_left_y + height - 256, op);
+		height = 256 - top_left_y;
+	}
+
+	// Sanity check, then clip the far edges to the screen
+	if (top_left_x >= LCD_X || top_left_y >= LCD_Y) {
+		return;
+	}
+	if (width > LCD_X - top_left_x) width = LCD_X - top_left_x;
+	if (height > LCD_Y - top_left_y) height = LCD_Y - top_left_y;
+
+	unsigned char bottom = top_left_y + height - 1;
+	unsigned char first_row = top_left_y/8;
+	unsigned char last_row = bottom/8;
+
+	// Only the first and last rows can be partly covered
+	unsigned char top_mask = 0xFF << (top_left_y%8);
+	unsigned char bottom_mask = 0xFF >> (7 - bottom%8);
+
+	for (unsigned char row = first_row; row <= last_row; row++) {
+		unsigned char mask = 0xFF;
+		if (row == first_row) mask &= top_mask;
+		if (row == last_row) mask &= bottom_mask;
+
+		unsigned char *byte = &screen_buffer[row*LCD_X + top_left_x];
+		unsigned char *end = byte + width;
+
+		if (op == RECT_FILL) {
+			while (byte < end) *byte++ |= mask;
+		} else if (op == RECT_CLEAR) {
+			while (byte < end) *byte++ &= ~mask;
+		} else {
+			while (byte < end) *byte++ ^= mask;
+		}
+	}
+}
+
+void fill_rect(unsigned char top_left_x, unsigned char top_left_y, unsigned char width, unsigned char height) {
+	rect_op(top_left_x, top_left_y, width, height, RECT_FILL);
+}
+
+void clear_rect(unsigned char top_left_x, unsigned char top_left_y, unsigned char width, unsigned char height) {
+	rect_op(top_left_x, top_left_y, width, height, RECT_CLEAR);
+}
+
+void invert_rect(unsigned char top_left_x, unsigned char top_left_y, unsigned char width, unsigned char height) {
+	rect_op(top_left_x, top_left_y, width, height, RECT_INVERT);
+}
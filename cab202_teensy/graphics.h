@@ -43,4 +43,22 @@ void draw_line(unsigned char x1, unsigned char y1, unsigned char x2, unsigned ch
 void draw_char(unsigned char top_left_x, unsigned char top_left_y, char character);
 void draw_string(unsigned char top_left_x, unsigned char top_left_y, char *characters);
 
+/*
+ * draw_string for strings kept in flash, e.g. draw_string_P(0, 0, PSTR("Hi"))
+ * (string literals are otherwise copied into RAM at startup)
+ */
+void draw_string_P(unsigned char top_left_x, unsigned char top_left_y, const char *characters);
+
+/*
+ * Filled rectangles, clipped to the screen. Whole bytes are written
+ * across each bank the rectangle covers, so these are much cheaper than
+ * drawing the same area with lines or set_pixel
+ * (fill sets, clear unsets, and invert toggles every pixel inside)
+ * Coordinates wrap at 256 like set_pixel loops do, so x = -2 (254)
+ * with width 6 covers columns 0 to 3
+ */
+void fill_rect(unsigned char top_left_x, unsigned char top_left_y, unsigned char width, unsigned char height);
+void clear_rect(unsigned char top_left_x, unsigned char top_left_y, unsigned char width, unsigned char height);
+void invert_rect(unsigned char top_left_x, unsigned char top_left_y, unsigned char width, unsigned char height);
+
 #endif /* GRAPHICS_H_ */
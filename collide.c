@@ -0,0 +1,127 @@
+// Alien Advance
+// Michael Ebens
+
+#include "collide.h"
+
+// Times along the path are fractions of the frame, time / den, and
+// are compared by cross multiplying rather than dividing. den = 0
+// means the box doesn't move on that axis, so it overlaps for the
+// whole frame or not at all.
+typedef struct span {
+  int32_t enter, leave;
+  int16_t den;
+} Span;
+
+// When the moving edge p is strictly between lo and hi, returns 0 if
+// that never happens during the frame
+static uint8_t axis_span(int16_t p, int16_t d, int16_t lo, int16_t hi, Span* span)
+{
+  // mirror so the box always moves towards +
+  if (d < 0)
+  {
+    int16_t flip = lo;
+    lo = -hi;
+    hi = -flip;
+    p = -p;
+    d = -d;
+  }
+
+  span->den = d;
+  if (!d) return lo < p && p < hi;
+
+  span->enter = (int32_t) lo - p;
+  span->leave = (int32_t) hi - p;
+  return span->enter < d && span->leave > 0;
+}
+
+uint8_t sweep_hits(const Sweep* sweep, int16_t x, int16_t y, unsigned char width, unsigned char height)
+{
+  Span sx;
+  Span sy;
+
+  // grow the target by the moving box, then follow its corner
+  if (!axis_span(sweep->x, sweep->dx, x - (sweep->width << 8), x + (width << 8), &sx)) return 0;
+  if (!axis_span(sweep->y, sweep->dy, y - (sweep->height << 8), y + (height << 8), &sy)) return 0;
+  if (!sx.den || !sy.den) return 1;
+
+  // both axes overlap within the frame, and must do so at the same time
+  return sx.enter * sy.den < sy.leave * sx.den && sy.enter * sx.den < sx.leave * sy.den;
+}
+
+// one bitmap row, left aligned in 16 bits with the bits past the
+// sprite's width cleared (draw_sprite never draws them)
+static uint16_t bitmap_row(const unsigned char* bitmap, unsigned char width, unsigned char row)
+{
+  if (width > 8)
+  {
+    bitmap += row * 2;
+    return (((uint16_t) bitmap[0] << 8) | bitmap[1]) & (0xFFFF << (16 - width));
+  }
+
+  return ((uint16_t) bitmap[row] << 8) & (0xFF00 << (8 - width));
+}
+
+static uint8_t bitmaps_overlap(const unsigned char* a, unsigned char a_width, unsigned char a_height, int16_t ax, int16_t ay,
+                               const unsigned char* b, unsigned char b_width, unsigned char b_height, int16_t bx, int16_t by)
+{
+  int16_t shift = bx - ax;
+  if (shift >= 16 || shift <= -16) return 0;
+
+  int16_t top = ay > by ? ay : by;
+  int16_t bottom = ay + a_height < by + b_height ? ay + a_height : by + b_height;
+
+  for (int16_t y = top; y < bottom; y++)
+  {
+    uint16_t row_a = bitmap_row(a, a_width, y - ay);
+    uint16_t row_b = bitmap_row(b, b_width, y - by);
+
+    if (shift >= 0 ? row_a & (row_b >> shift) : (row_a >> -shift) & row_b) return 1;
+  }
+
+  return 0;
+}
+
+uint8_t sprites_overlap(const Sprite* a, const Sprite* b)
+{
+  // truncated to whole pixels the same way as draw_sprite()
+  return bitmaps_overlap(a->bitmap, a->width, a->height, (unsigned char) a->x, (unsigned char) a->y,
+                         b->bitmap, b->width, b->height, (unsigned char) b->x, (unsigned char) b->y);
+}
+
+uint8_t sweep_overlaps(const Sweep* sweep, const Sprite* target)
+{
+  int16_t tx = (unsigned char) target->x;
+  int16_t ty = (unsigned char) target->y;
+
+  // Walk every pixel position the top left corner passes through, one
+  // axis at a time, so diagonal moves can't skip past a corner. next_x
+  // and next_y are the distances to the next pixel boundary in the
+  // direction of travel, compared as times by cross multiplying.
+  int16_t x = sweep->x >> 8;
+  int16_t y = sweep->y >> 8;
+  int16_t end_x = (sweep->x + sweep->dx) >> 8;
+  int16_t end_y = (sweep->y + sweep->dy) >> 8;
+  int16_t dist_x = sweep->dx < 0 ? -sweep->dx : sweep->dx;
+  int16_t dist_y = sweep->dy < 0 ? -sweep->dy : sweep->dy;
+  int16_t next_x = sweep->dx < 0 ? sweep->x & 0xFF : 256 - (sweep->x & 0xFF);
+  int16_t next_y = sweep->dy < 0 ? sweep->y & 0xFF : 256 - (sweep->y & 0xFF);
+
+  while (1)
+  {
+    if (bitmaps_overlap(sweep->bitmap, sweep->width, sweep->height, x, y,
+                        target->bitmap, target->width, target->height, tx, ty)) return 1;
+
+    if (x == end_x && y == end_y) return 0;
+
+    if (y == end_y || (x != end_x && (int32_t) next_x * dist_y < (int32_t) next_y * dist_x))
+    {
+      x += sweep->dx < 0 ? -1 : 1;
+      next_x += 256;
+    }
+    else
+    {
+      y += sweep->dy < 0 ? -1 : 1;
+      next_y += 256;
+    }
+  }
+}
@@ -0,0 +1,43 @@
+// Alien Advance
+// Michael Ebens
+
+// Swept box collision in 8.8 fixed point pixels. A box moving from
+// (x, y) by (dx, dy) over a frame is tested against a stationary box
+// along its whole path, so a long frame can't carry a missile through
+// a target between two sampled positions.
+//
+// Boxes touching edge to edge don't collide, the same as the
+// !(a.x >= b.x + b.width || ...) tests in main.c.
+//
+// Once boxes overlap, the pixel exact tests AND the overlapping rows of
+// the sprites' own bitmaps, placed where draw_sprite() draws them, so
+// only hits on set pixels count. Bitmaps can be up to 16 pixels wide.
+
+#ifndef COLLIDE_H_
+#define COLLIDE_H_
+
+#include <stdint.h>
+
+#include <sprite.h>
+
+// pixels to 8.8 fixed point, good for the whole screen
+#define FIX8(f) ((int16_t) ((f) * 256))
+
+typedef struct sweep {
+  int16_t x, y;   // top left corner at the start of the frame
+  int16_t dx, dy; // movement over the frame
+  unsigned char width, height;
+  const unsigned char* bitmap;
+} Sweep;
+
+// 1 if the moving box overlaps the box at (x, y) at any point of its path
+uint8_t sweep_hits(const Sweep* sweep, int16_t x, int16_t y, unsigned char width, unsigned char height);
+
+// pixel exact, for sprites whose boxes overlap
+uint8_t sprites_overlap(const Sprite* a, const Sprite* b);
+
+// pixel exact sweep_hits(), stepping the bitmap along the path at most a
+// pixel at a time
+uint8_t sweep_overlaps(const Sweep* sweep, const Sprite* target);
+
+#endif /* COLLIDE_H_ */
@@ -0,0 +1,148 @@
+// Alien Advance
+// Michael Ebens
+
+// Compile time configuration. Every value can be overridden per
+// product variant from the make command line, e.g.
+//   make CONFIG="-DNUM_ENEMIES=8 -DENABLE_SCREEN_MIRROR=1"
+// RAM use derived from these is checked here, and the linked image is
+// checked against RAM_BUDGET/FLASH_BUDGET by the Makefile.
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include "format.h"
+
+// pools
+
+#ifndef NUM_ENEMIES
+#define NUM_ENEMIES 6
+#endif
+
+#ifndef NUM_MISSILES
+#define NUM_MISSILES 5
+#endif
+
+#ifndef MOTHER_MAX_HEALTH
+#define MOTHER_MAX_HEALTH 15
+#endif
+
+#ifndef AI_DECISIONS_PER_FRAME
+#define AI_DECISIONS_PER_FRAME 2 // enemies allowed to re-aim each frame
+#endif
+
+#ifndef MAX_SKIPPED_RENDERS
+#define MAX_SKIPPED_RENDERS 1 // overrun frames in a row that skip drawing
+#endif
+
+// light, debug, input, mothership move/shoot, then one per enemy
+#define NUM_TIMERS (5 + NUM_ENEMIES)
+
+// missiles then enemies, in sap.c
+#define SAP_BODIES (NUM_MISSILES + NUM_ENEMIES)
+
+#ifndef TIMER_WHEEL_SLOTS
+#define TIMER_WHEEL_SLOTS 32 // timer_wheel.c, power of two
+#endif
+
+// sprite dimensions (must match the bitmaps in main.c)
+
+#define PWIDTH 5
+#define PHEIGHT 5
+#define EWIDTH 5
+#define EHEIGHT 5
+#define MSWIDTH 12
+#define MSHEIGHT 12
+#define MWIDTH 2
+#define MHEIGHT 2
+
+// buffers
+
+#ifndef DEBUG_BUFF_SIZE
+#define DEBUG_BUFF_SIZE 96 // formatted text, buff in main.c
+#endif
+
+#ifndef TIME_BUFF_SIZE
+#define TIME_BUFF_SIZE 24 // debug preamble, time_buff in main.c
+#endif
+
+#ifndef INPUT_QUEUE_SIZE
+#define INPUT_QUEUE_SIZE 16 // button events, power of two
+#endif
+
+#ifndef TX_RING_SIZE
+#define TX_RING_SIZE 128 // USB transmit ring, power of two up to 128
+#endif
+
+// optional features
+
+#ifndef ENABLE_SCREEN_MIRROR
+#define ENABLE_SCREEN_MIRROR 0 // screen_mirror.c, costs a screen copy (SCREEN_RAM)
+#endif
+
+#ifndef MIRROR_TEXT_HEADROOM
+#define MIRROR_TEXT_HEADROOM 64 // transmit ring bytes the mirror leaves for debug lines
+#endif
+
+#ifndef ENABLE_PROFILING
+#define ENABLE_PROFILING 0 // profile.c cycle counting, uses timer3 (make bench turns it on)
+#endif
+
+#ifndef ENABLE_BENCH
+#define ENABLE_BENCH 0 // bench.c, the game built to run under simavr (make bench)
+#endif
+
+#ifndef BENCH_FRAMES
+#define BENCH_FRAMES 1000 // frames the bench plays before reporting
+#endif
+
+// replay
+
+#ifndef RNG_SEED
+#define RNG_SEED 0 // 0 = seed from the first button press, see rng.h
+#endif
+
+// RAM budget
+// The ATmega32U4 has 2560 bytes, the rest is left for the stack.
+
+#ifndef RAM_BUDGET
+#define RAM_BUDGET 2048
+#endif
+
+#define SCREEN_RAM (84 * 48 / 8)
+#define SPRITE_RAM 21 // sizeof(Sprite), checked in main.c
+#define INPUT_EVENT_RAM 4 // sizeof(InputEvent), checked in input_queue.c
+#define SWEEP_RAM 12 // sizeof(Sweep), checked in main.c
+
+#define BUFFER_RAM (SCREEN_RAM + (ENABLE_SCREEN_MIRROR ? SCREEN_RAM : 0) + TX_RING_SIZE \
+  + DEBUG_BUFF_SIZE + TIME_BUFF_SIZE + INPUT_QUEUE_SIZE * INPUT_EVENT_RAM)
+
+// player, enemies, mothership, mother missile, missiles, timers,
+// missile paths and sweep and prune extents
+#define POOL_RAM ((3 + NUM_ENEMIES + NUM_MISSILES) * SPRITE_RAM + NUM_TIMERS * (sizeof(uint32_t) + 3) + TIMER_WHEEL_SLOTS \
+  + NUM_MISSILES * SWEEP_RAM + SAP_BODIES * 5)
+
+// everything else in .data/.bss, sized from nm with AVR widths: game
+// scalars and sprite bitmaps in main.c (77), the other modules (43)
+// and usb_serial.c (18), plus the screen_mirror.c and profile.c state
+// when built in. String literals would be copied into .data too, so
+// they're kept in flash with PSTR and the _P functions instead.
+#define STATE_RAM (138 + (ENABLE_SCREEN_MIRROR ? 9 : 0) + (ENABLE_PROFILING ? 35 : 0))
+
+#define CONFIG_RAM (BUFFER_RAM + POOL_RAM + STATE_RAM)
+
+_Static_assert(CONFIG_RAM <= RAM_BUDGET, "configuration does not fit in RAM_BUDGET");
+_Static_assert(NUM_ENEMIES >= 1 && NUM_ENEMIES <= 255, "NUM_ENEMIES must fit in an unsigned char");
+_Static_assert(NUM_MISSILES >= 1 && NUM_MISSILES <= 255, "NUM_MISSILES must fit in an unsigned char");
+_Static_assert(MOTHER_MAX_HEALTH >= 1 && MOTHER_MAX_HEALTH <= 255, "MOTHER_MAX_HEALTH must fit in an unsigned char");
+_Static_assert((INPUT_QUEUE_SIZE & (INPUT_QUEUE_SIZE - 1)) == 0 && INPUT_QUEUE_SIZE <= 128, "INPUT_QUEUE_SIZE must be a power of two up to 128");
+_Static_assert(PWIDTH <= 16 && EWIDTH <= 16 && MSWIDTH <= 16 && MWIDTH <= 16, "collide.c handles sprites up to 16 pixels wide");
+_Static_assert(AI_DECISIONS_PER_FRAME >= 1 && AI_DECISIONS_PER_FRAME <= 255, "AI_DECISIONS_PER_FRAME must fit in an unsigned char");
+_Static_assert(MAX_SKIPPED_RENDERS >= 0 && MAX_SKIPPED_RENDERS < 255, "MAX_SKIPPED_RENDERS must fit in an unsigned char");
+_Static_assert(SAP_BODIES <= 255, "SAP_BODIES must fit in an unsigned char");
+_Static_assert(NUM_TIMERS < 255, "NUM_TIMERS must leave 0xFF free in timer_wheel.c");
+_Static_assert((TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1)) == 0 && TIMER_WHEEL_SLOTS <= 128, "TIMER_WHEEL_SLOTS must be a power of two up to 128");
+_Static_assert((TX_RING_SIZE & (TX_RING_SIZE - 1)) == 0 && TX_RING_SIZE <= 128, "TX_RING_SIZE must be a power of two up to 128");
+_Static_assert(DEBUG_BUFF_SIZE >= 80, "DEBUG_BUFF_SIZE is too small for the debug messages");
+_Static_assert(TIME_BUFF_SIZE >= 9 + FMT_MAX_LENGTH + 2, "TIME_BUFF_SIZE is too small for the debug preamble");
+
+#endif /* CONFIG_H_ */
@@ -0,0 +1,117 @@
+// Alien Advance
+// Michael Ebens
+
+#include "config.h"
+#include "console_input.h"
+#include "usb_serial.h"
+
+#define CONSOLE_READ_SIZE 16
+
+// the bench build plays a script instead (bench.h)
+#if ENABLE_BENCH
+#include "bench.h"
+#define console_read bench_keys
+#else
+#define console_read usb_serial_read
+#endif
+
+unsigned char console_states = 0;
+unsigned char console_pressed = 0;
+
+// held by tapping (auto-repeat) rather than an explicit key down
+static unsigned char console_tapped = 0;
+static uint16_t tap_ticks[CONSOLE_NUM_KEYS];
+
+// '+' or '-' when the next key is an explicit down/up message
+static char prefix = 0;
+
+static int8_t key_index(uint8_t c)
+{
+  switch (c)
+  {
+    case 'a': return CONSOLE_LEFT;
+    case 'd': return CONSOLE_RIGHT;
+    case 'w': return CONSOLE_UP;
+    case 's': return CONSOLE_DOWN;
+    case ' ': return CONSOLE_SHOOT;
+    case 'm': return CONSOLE_MIRROR;
+  }
+
+  return -1;
+}
+
+static void parse(uint8_t c, uint16_t now)
+{
+  if (c == '+' || c == '-')
+  {
+    prefix = c;
+    return;
+  }
+
+  int8_t key = key_index(c);
+
+  if (key != -1)
+  {
+    unsigned char mask = CONSOLE_MASK(key);
+
+    if (prefix == '-')
+    {
+      console_states &= ~mask;
+      console_tapped &= ~mask;
+    }
+    else
+    {
+      if (prefix == '+')
+      {
+        if (!(console_states & mask)) console_pressed |= mask;
+        console_tapped &= ~mask;
+      }
+      else
+      {
+        if (!(console_states & mask & CONSOLE_TOGGLE_KEYS)) console_pressed |= mask;
+        console_tapped |= mask;
+        tap_ticks[key] = now;
+      }
+
+      console_states |= mask;
+    }
+  }
+
+  prefix = 0;
+}
+
+void console_poll(uint16_t now)
+{
+  uint8_t buff[CONSOLE_READ_SIZE];
+  uint8_t n;
+
+  console_pressed = 0;
+
+  while ((n = console_read(buff, CONSOLE_READ_SIZE)))
+  {
+    for (uint8_t i = 0; i < n; i++) parse(buff[i], now);
+  }
+
+  // tapped keys are released once their repeats stop
+  if (console_tapped)
+  {
+    for (unsigned char key = 0; key < CONSOLE_NUM_KEYS; key++)
+    {
+      unsigned char mask = CONSOLE_MASK(key);
+
+      if ((console_tapped & mask) && (uint16_t) (now - tap_ticks[key]) >= CONSOLE_TAP_HOLD)
+      {
+        console_states &= ~mask;
+        console_tapped &= ~mask;
+      }
+    }
+  }
+}
+
+void console_reset(void)
+{
+  console_states = 0;
+  console_pressed = 0;
+  console_tapped = 0;
+  prefix = 0;
+}
@@ -0,0 +1,52 @@
+// Alien Advance
+// Michael Ebens
+
+// Parser for console control over the USB serial link.
+//
+// Protocol, one byte per key (w, a, s, d, space or m):
+//   key      tap, a press held for CONSOLE_TAP_HOLD; terminal auto-repeat
+//            keeps a held key down and presses it again on every
+//            repeat, so holding space keeps firing (except the
+//            CONSOLE_TOGGLE_KEYS, pressed once per hold)
+//   +key     key down, held until the matching key up
+//   -key     key up
+
+#ifndef CONSOLE_INPUT_H_
+#define CONSOLE_INPUT_H_
+
+#include <stdint.h>
+
+#include "ticks.h"
+
+#define CONSOLE_LEFT 0
+#define CONSOLE_RIGHT 1
+#define CONSOLE_UP 2
+#define CONSOLE_DOWN 3
+#define CONSOLE_SHOOT 4
+#define CONSOLE_MIRROR 5
+#define CONSOLE_NUM_KEYS 6
+
+#define CONSOLE_MASK(key) (1 << (key))
+
+// keys that switch something on and off, so auto-repeat mustn't press
+// them again while they're held
+#define CONSOLE_TOGGLE_KEYS CONSOLE_MASK(CONSOLE_MIRROR)
+
+// a few frames for a lone tap, and longer than the gap between
+// auto-repeats (~33ms) so a held key doesn't drop out between them
+#define CONSOLE_TAP_HOLD ((uint16_t) TICKS_MS(100))
+
+extern unsigned char console_states;  // keys currently held
+extern unsigned char console_pressed; // keys that went down in the last poll
+
+#define CONSOLE_IS_DOWN(key) (console_states & CONSOLE_MASK(key))
+#define CONSOLE_WAS_PRESSED(key) (console_pressed & CONSOLE_MASK(key))
+
+// read everything waiting on the USB link and update the key states,
+// now is the current timer1 count
+void console_poll(uint16_t now);
+
+// release all keys, e.g. when a new round starts
+void console_reset(void);
+
+#endif /* CONSOLE_INPUT_H_ */
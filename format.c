@@ -0,0 +1,85 @@
+// Alien Advance
+// Michael Ebens
+
+#include <avr/pgmspace.h>
+
+#include "format.h"
+
+// digits are produced least significant first into a scratch buffer,
+// then copied out in the right order behind any sign and padding
+
+static char* emit(char* dst, uint32_t value, uint8_t negative, uint8_t decimals, uint8_t width, char pad)
+{
+  char digits[FMT_MAX_LENGTH];
+  uint8_t n = 0;
+
+  // always produce at least one digit before the point
+  do
+  {
+    if (decimals && n == decimals) digits[n++] = '.';
+    digits[n++] = '0' + value % 10;
+    value /= 10;
+  }
+  while (value || n <= decimals);
+
+  if (negative && pad == '0') *dst++ = '-';
+  for (uint8_t len = n + negative; len < width; len++) *dst++ = pad;
+  if (negative && pad != '0') *dst++ = '-';
+
+  while (n) *dst++ = digits[--n];
+  *dst = '\0';
+  return dst;
+}
+
+char* fmt_str(char* dst, const char* src)
+{
+  while (*src != '\0') *dst++ = *src++;
+  *dst = '\0';
+  return dst;
+}
+
+char* fmt_str_P(char* dst, const char* src)
+{
+  char c;
+  while ((c = pgm_read_byte(src++)) != '\0') *dst++ = c;
+  *dst = '\0';
+  return dst;
+}
+
+char* fmt_char(char* dst, char c)
+{
+  *dst++ = c;
+  *dst = '\0';
+  return dst;
+}
+
+char* fmt_uint(char* dst, uint32_t value, uint8_t width, char pad)
+{
+  return emit(dst, value, 0, 0, width, pad);
+}
+
+char* fmt_int(char* dst, int32_t value, uint8_t width, char pad)
+{
+  if (value < 0) return emit(dst, -(uint32_t) value, 1, 0, width, pad);
+  return emit(dst, value, 0, 0, width, pad);
+}
+
+char* fmt_fixed(char* dst, int32_t value, uint8_t decimals, uint8_t width)
+{
+  if (value < 0) return emit(dst, -(uint32_t) value, 1, decimals, width, ' ');
+  return emit(dst, value, 0, decimals, width, ' ');
+}
+
+char* fmt_hex(char* dst, uint32_t value, uint8_t digits)
+{
+  if (digits > 8) digits = 8;
+
+  for (int8_t shift = (digits - 1) * 4; shift >= 0; shift -= 4)
+  {
+    uint8_t nibble = (value >> shift) & 0xF;
+    *dst++ = nibble < 10 ? '0' + nibble : 'A' - 10 + nibble;
+  }
+
+  *dst = '\0';
+  return dst;
+}
@@ -0,0 +1,36 @@
+// Alien Advance
+// Michael Ebens
+
+// Integer-only text formatting, used in place of sprintf so that
+// neither vfprintf nor printf_flt need to be linked in.
+//
+// Every emitter writes into a caller supplied buffer, null terminates
+// it, and returns a pointer to the terminator so calls can be chained:
+//
+//   char* p = fmt_str(buff, "S:");
+//   p = fmt_uint(p, score, 0, ' ');
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#include <stdint.h>
+
+// longest output of any single emitter (sign + 10 digits + point + null)
+#define FMT_MAX_LENGTH 13
+
+char* fmt_str(char* dst, const char* src);
+char* fmt_str_P(char* dst, const char* src); // src in program memory (PSTR)
+char* fmt_char(char* dst, char c);
+
+// decimal integers, left padded with pad to at least width characters
+char* fmt_uint(char* dst, uint32_t value, uint8_t width, char pad);
+char* fmt_int(char* dst, int32_t value, uint8_t width, char pad);
+
+// fixed point decimal, value is scaled by 10^decimals
+// e.g. fmt_fixed(dst, 12345, 3, 6) gives "12.345"
+char* fmt_fixed(char* dst, int32_t value, uint8_t decimals, uint8_t width);
+
+// upper case hex, zero padded to digits characters (at most 8)
+char* fmt_hex(char* dst, uint32_t value, uint8_t digits);
+
+#endif /* FORMAT_H_ */
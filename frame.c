@@ -0,0 +1,88 @@
+// Alien Advance
+// Michael Ebens
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+#include "frame.h"
+
+static volatile uint8_t frame_due = 0;
+static uint16_t frame_start = 0;
+
+// accumulated since the last frame_duty() call
+static uint32_t busy_ticks = 0;
+static uint32_t total_ticks = 0;
+
+void frame_init(void)
+{
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  frame_start = (uint16_t) ticks_now();
+}
+
+void frame_begin(void)
+{
+  frame_start = (uint16_t) ticks_now();
+}
+
+void frame_idle(void)
+{
+  sleep_mode();
+}
+
+uint8_t frame_wait(uint16_t period)
+{
+  uint16_t deadline = frame_start + period;
+
+  cli();
+  uint16_t now = TCNT1;
+  busy_ticks += (uint16_t) (now - frame_start);
+
+  if ((uint16_t) (now - frame_start) >= period)
+  {
+    // overrun, start the next frame right away
+    sei();
+    total_ticks += (uint16_t) (now - frame_start);
+    frame_start = now;
+    return 1;
+  }
+
+  frame_due = 0;
+  OCR1A = deadline;
+  TIFR1 = (1 << OCF1A);
+  TIMSK1 |= (1 << OCIE1A);
+
+  // the deadline may have passed while the compare was being armed
+  if ((uint16_t) (TCNT1 - frame_start) >= period) frame_due = 1;
+
+  while (!frame_due)
+  {
+    // sei takes effect after the next instruction, so an interrupt
+    // can't slip in between the check and going to sleep
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+    cli();
+  }
+
+  TIMSK1 &= ~(1 << OCIE1A);
+  sei();
+
+  total_ticks += period;
+  frame_start = deadline;
+  return 0;
+}
+
+uint16_t frame_duty(void)
+{
+  uint16_t duty = total_ticks ? busy_ticks * 1000 / total_ticks : 0;
+  busy_ticks = 0;
+  total_ticks = 0;
+  return duty;
+}
+
+ISR(TIMER1_COMPA_vect)
+{
+  frame_due = 1;
+}
@@ -0,0 +1,35 @@
+// Alien Advance
+// Michael Ebens
+
+// Frame pacing on top of the timer1 system clock. Instead of busy
+// waiting, the CPU is put into IDLE sleep until the timer1 compare A
+// interrupt marks the end of the frame (or any other interrupt, such
+// as USB or the debouncing timer, wakes it for idle()).
+
+#ifndef FRAME_H_
+#define FRAME_H_
+
+#include <stdint.h>
+
+#include "ticks.h"
+
+// frame periods are in timer1 ticks, see ticks.h
+#define FRAME_MS(ms) ((uint16_t) TICKS_MS(ms))
+
+void frame_init(void);
+
+// start a new frame now, e.g. after sleeping in frame_idle()
+void frame_begin(void);
+
+// sleep until period ticks have passed since the start of the current
+// frame, then begin the next frame; returns 1 straight away if the
+// frame has already overrun
+uint8_t frame_wait(uint16_t period);
+
+// sleep until the next interrupt of any kind
+void frame_idle(void);
+
+// CPU busy time since the last call, in tenths of a percent
+uint16_t frame_duty(void);
+
+#endif /* FRAME_H_ */
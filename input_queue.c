@@ -0,0 +1,11 @@
+// Alien Advance
+// Michael Ebens
+
+#include "input_queue.h"
+
+InputEvent input_queue[INPUT_QUEUE_SIZE];
+volatile uint8_t input_queue_head = 0;
+volatile uint8_t input_queue_tail = 0;
+volatile uint8_t input_queue_dropped = 0;
+
+_Static_assert(sizeof(InputEvent) == INPUT_EVENT_RAM, "INPUT_EVENT_RAM in config.h is out of date");
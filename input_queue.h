@@ -0,0 +1,58 @@
+// Alien Advance
+// Michael Ebens
+
+// Lock-free single producer/single consumer queue of button edges.
+// The debouncing ISR is the only producer and the main loop the only
+// consumer; each side owns one index, and single byte loads/stores are
+// atomic on the AVR, so no interrupt masking is needed.
+
+#ifndef INPUT_QUEUE_H_
+#define INPUT_QUEUE_H_
+
+#include <stdint.h>
+
+#include "config.h"
+
+typedef struct input_event {
+  uint16_t ticks;         // TCNT1 when the edge was debounced
+  unsigned char button;   // BTN_* index
+  unsigned char pressed;  // 1 = press, 0 = release
+} InputEvent;
+
+extern InputEvent input_queue[INPUT_QUEUE_SIZE];
+extern volatile uint8_t input_queue_head;  // written by producer only
+extern volatile uint8_t input_queue_tail;  // written by consumer only
+extern volatile uint8_t input_queue_dropped;
+
+// producer side, call from the ISR only
+static inline void push_input_event(uint16_t ticks, unsigned char button, unsigned char pressed)
+{
+  uint8_t head = input_queue_head;
+
+  if ((uint8_t) (head - input_queue_tail) >= INPUT_QUEUE_SIZE)
+  {
+    input_queue_dropped++;
+    return;
+  }
+
+  InputEvent* event = &input_queue[head & (INPUT_QUEUE_SIZE - 1)];
+  event->ticks = ticks;
+  event->button = button;
+  event->pressed = pressed;
+  __asm__ __volatile__ ("" ::: "memory");
+  input_queue_head = head + 1; // publish after the slot is written
+}
+
+// consumer side, returns 0 when the queue is empty
+static inline uint8_t pop_input_event(InputEvent* event)
+{
+  uint8_t tail = input_queue_tail;
+  if (tail == input_queue_head) return 0;
+
+  *event = input_queue[tail & (INPUT_QUEUE_SIZE - 1)];
+  __asm__ __volatile__ ("" ::: "memory");
+  input_queue_tail = tail + 1; // release the slot after copying
+  return 1;
+}
+
+#endif /* INPUT_QUEUE_H_ */
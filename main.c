@@ -9,23 +9,37 @@
 // Console controls:
 // WASD to move ship
 // Space to shoot
+// M to toggle mirroring the screen over USB (view with tools/mirror_decode),
+// in builds with ENABLE_SCREEN_MIRROR=1
+// (prefix a key with + or - to send explicit key down/up, see console_input.h)
 
-#include <stdlib.h>
-#include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
-#include <util/delay.h>
+#include <avr/pgmspace.h>
 
 #include <cpu_speed.h>
 #include <lcd.h>
 #include <graphics.h>
 #include <sprite.h>
 
+#include "config.h"
 #include "usb_serial.h"
-
-#define PI 3.141592653589
+#include "format.h"
+#include "ticks.h"
+#include "frame.h"
+#include "timer_wheel.h"
+#include "input_queue.h"
+#include "console_input.h"
+#include "screen_mirror.h"
+#include "profile.h"
+#include "rng.h"
+#include "collide.h"
+#include "sap.h"
+#include "aim.h"
+#include "bench.h"
 
 // bit operations
 
@@ -46,52 +60,63 @@
 #define BTN_LEFT 5
 #define BTN_RIGHT 6
 
-#define BTN_STATE_UP 0
-#define BTN_STATE_DOWN 1
+#define BTN_MASK(btn) (1 << (btn))
+#define BTN_IS_DOWN(btn) (btn_states & BTN_MASK(btn))
 
 // input states
+// one bit per button, bit n is button n from above
+
+volatile unsigned char btn_states = 0;
+
+// two bit vertical counters, one column per button
+unsigned char btn_count0 = 0xFF;
+unsigned char btn_count1 = 0xFF;
 
-volatile unsigned char btn_hists[NUM_BUTTONS];
-volatile unsigned char btn_states[NUM_BUTTONS];
-volatile unsigned int press_count = 0;
-volatile unsigned char btn_right_pressed = 0;
+// press/release edges are queued by the debouncing ISR (input_queue.h)
+// and drained once per frame
+unsigned char btn_right_presses = 0;
+uint16_t max_input_latency = 0; // timer1 ticks, since the last report
+uint32_t last_usb_sent = 0;
+unsigned int debug_dropped = 0; // lines that didn't fit in the transmit ring
 
-unsigned char usb_left = 0;
-unsigned char usb_right = 0;
-unsigned char usb_up = 0;
-unsigned char usb_down = 0;
-unsigned char usb_shoot = 0;
+// the 0.5s report is sent a line per frame, so every line fits
+#define REPORT_LINES (ENABLE_PROFILING ? 7 : 5)
+unsigned char report_line = REPORT_LINES; // next line, REPORT_LINES when done
 
 // -1 = waiting for/connected to USB
 // 0 = intro
 // 1 = countdown
 // 2 = gameplay
 // 3 = game over
-char GAME_STATE = -1;
+char GAME_STATE = ENABLE_BENCH ? 1 : -1; // the bench has no USB host to wait for
 unsigned char mothership_battle = 0;
 unsigned char lives = 10;
 unsigned int score = 0;
 unsigned char countdown = 4;
 
 // timers
+// all in timer1 ticks (ticks.h), countdowns are kept in timer_wheel.h
 
-float time = 0;
-float last_clock = 0;
-float DT;
-float light_timer = 0;
-float debug_timer = 0.5;
-float input_timer = 0;
-float first_input_time = 0;
-unsigned int clock_overflow = 0;
+uint32_t frame_ticks = 0; // ticks_now() at the start of the frame
+uint32_t round_start = 0;
+float DT; // seconds since the last frame, for movement
+unsigned char rng_seeded = 0;
 
-// 7812.5 = 8MHz / 1024 (freq / prescaler)
-#define TIMER1_TIME (1 / 7812.5)
-#define TIMER1_OVERFLOW (TIMER1_TIME * 0xFFFF)
+#define TIMER_LIGHT 0
+#define TIMER_DEBUG 1
+#define TIMER_INPUT 2
+#define TIMER_MOTHER_MOVE 3
+#define TIMER_MOTHER_SHOOT 4
+#define TIMER_ENEMY(i) (5 + (i))
 
-// player 
+// frame budget watchdog (MAX_SKIPPED_RENDERS in config.h)
+
+unsigned char render_frame = 1;
+unsigned char skipped_in_row = 0;
+unsigned int frame_overruns = 0;
+unsigned int render_skips = 0;
 
-#define PWIDTH 5
-#define PHEIGHT 5
+// player 
 
 unsigned char player_bitmap[] = {
   0b11111000,
@@ -105,10 +130,6 @@ Sprite player;
 
 // enemies
 
-#define NUM_ENEMIES 6
-#define EWIDTH 5
-#define EHEIGHT 5
-
 unsigned char enemy_bitmap[] = {
   0b10001000,
   0b01010000,
@@ -118,14 +139,11 @@ unsigned char enemy_bitmap[] = {
 };
 
 Sprite enemies[NUM_ENEMIES];
-float enemy_timers[NUM_ENEMIES];
 unsigned char enemies_alive = NUM_ENEMIES;
+unsigned char ai_next = 0; // first enemy offered a decision next frame
 
 // mothership
 
-#define MSWIDTH 12
-#define MSHEIGHT 12
-
 unsigned char mothership_bitmap[] = {
   0b00101111, 0b01000000,
   0b01001111, 0b00100000,
@@ -144,55 +162,198 @@ unsigned char mothership_bitmap[] = {
 Sprite mothership;
 Sprite mother_missile;
 
-#define MOTHER_MAX_HEALTH 15
 unsigned char mother_health = MOTHER_MAX_HEALTH;
-float mother_move_timer;
-float mother_shoot_timer;
 
 // missiles
 
-#define NUM_MISSILES 5
-#define MWIDTH 2
-#define MHEIGHT 2
-
 unsigned char missile_bitmap[] = {
   0b1100000,
   0b1100000
 };
 
 Sprite missiles[NUM_MISSILES];
+Sweep missile_paths[NUM_MISSILES]; // movement this frame, for hit tests
 
 // character buffers
 
-char buff[80];
-char time_buff[18];
+char buff[DEBUG_BUFF_SIZE];
+char time_buff[TIME_BUFF_SIZE];
 
-float get_system_time()
+#if ENABLE_PROFILING
+static const char prof_names[] PROGMEM = PROF_NAMES;
+#endif
+
+// keep the estimates in config.h honest
+_Static_assert(sizeof(Sprite) == SPRITE_RAM, "SPRITE_RAM in config.h is out of date");
+_Static_assert(sizeof(Sweep) == SWEEP_RAM, "SWEEP_RAM in config.h is out of date");
+_Static_assert(sizeof(player_bitmap) == PHEIGHT * ((PWIDTH + 7) / 8), "player_bitmap doesn't match PWIDTH/PHEIGHT");
+_Static_assert(sizeof(enemy_bitmap) == EHEIGHT * ((EWIDTH + 7) / 8), "enemy_bitmap doesn't match EWIDTH/EHEIGHT");
+_Static_assert(sizeof(mothership_bitmap) == MSHEIGHT * ((MSWIDTH + 7) / 8), "mothership_bitmap doesn't match MSWIDTH/MSHEIGHT");
+_Static_assert(sizeof(missile_bitmap) == MHEIGHT * ((MWIDTH + 7) / 8), "missile_bitmap doesn't match MWIDTH/MHEIGHT");
+_Static_assert(TIMER_ENEMY(NUM_ENEMIES) == NUM_TIMERS, "NUM_TIMERS in config.h is out of date");
+
+void drain_input_events()
 {
-  return (clock_overflow * 65536 + TCNT1) * TIMER1_TIME;
+  InputEvent event;
+  uint16_t now = (uint16_t) ticks_now();
+
+  btn_right_presses = 0;
+
+  while (pop_input_event(&event))
+  {
+    uint16_t latency = now - event.ticks;
+    if (latency > max_input_latency) max_input_latency = latency;
+
+    if (event.pressed && event.button == BTN_RIGHT) btn_right_presses++;
+  }
 }
 
-float get_system_clock()
+// string is in program memory when in_flash is set
+void send_debug_line(const char* string, unsigned char in_flash)
 {
-  return TIMER1_TIME * TCNT1;
+#if ENABLE_BENCH
+    if (in_flash) bench_write_P(string);
+    else bench_write(string);
+    return;
+#endif
+
+    // Format the debug preamble straight into the transmit ring when
+    // there's room, otherwise go through time_buff
+    uint8_t size = sizeof(time_buff);
+    char* preamble = (char*) usb_serial_tx_reserve(&size);
+    if (size < sizeof(time_buff)) preamble = time_buff;
+
+    char* end = fmt_str_P(preamble, PSTR("[DEBUG @ "));
+    end = fmt_fixed(end, ticks_to_ms(ticks_now()), 3, 6);
+    end = fmt_str_P(end, PSTR("] "));
+
+    // a line that doesn't fit is dropped whole, never cut short or
+    // mixed into other output (the reserved preamble isn't committed)
+    uint16_t length = in_flash ? strlen_P(string) : strlen(string);
+
+    if (usb_serial_tx_free() < (end - preamble) + length + 2)
+    {
+      debug_dropped++;
+      return;
+    }
+
+    if (preamble == time_buff)
+    {
+      usb_serial_tx_write((const uint8_t *) time_buff, end - time_buff);
+    }
+    else
+    {
+      usb_serial_tx_commit(end - preamble);
+    }
+    
+    // Send all of the characters in the string
+    if (in_flash) usb_serial_tx_write_P((const uint8_t *) string, length);
+    else usb_serial_tx_write((const uint8_t *) string, length);
+
+    // Go to a new line (force this to be the start of the line)
+    usb_serial_tx_write_P((const uint8_t *) PSTR("\r\n"), 2);
 }
 
 void send_debug_string(char* string)
 {
-    // Send the debug preamble...
-    sprintf(time_buff, "[DEBUG @ %6.3f] ", (double) get_system_time());
-    usb_serial_write((const uint8_t *) time_buff, 18);
-    
-    // Send all of the characters in the string
-    while (*string != '\0')
+  send_debug_line(string, 0);
+}
+
+// for literals, kept out of RAM: send_debug_string_P(PSTR("..."))
+void send_debug_string_P(const char* string)
+{
+  send_debug_line(string, 1);
+}
+
+// one line of the 0.5s debug report
+void send_report_line(unsigned char line, uint8_t player_direction)
+{
+  char* end = buff;
+
+  switch (line)
+  {
+    case 0:
+      end = fmt_str_P(buff, PSTR("Player's current position: ("));
+      end = fmt_uint(end, (unsigned char) player.x, 0, ' ');
+      end = fmt_str_P(end, PSTR(", "));
+      end = fmt_uint(end, (unsigned char) player.y, 0, ' ');
+      fmt_char(end, ')');
+      break;
+
+    case 1:
+      // aim in tenths of a degree
+      end = fmt_str_P(buff, PSTR("Player's current aim: "));
+      fmt_fixed(end, AIM_DECIDEGREES(player_direction), 1, 0);
+      break;
+
+    case 2:
     {
-        usb_serial_putchar(*string);
-        string++;
+      // sent every 0.5s, so doubled for bytes per second
+      uint32_t usb_sent = usb_serial_tx_sent();
+      end = fmt_str_P(buff, PSTR("CPU duty: "));
+      end = fmt_fixed(end, frame_duty(), 1, 0);
+      end = fmt_str_P(end, PSTR("%, USB TX: "));
+      end = fmt_uint(end, (usb_sent - last_usb_sent) * 2, 0, ' ');
+      end = fmt_str_P(end, PSTR("B/s, lines dropped: "));
+      fmt_uint(end, debug_dropped, 0, ' ');
+      last_usb_sent = usb_sent;
+      break;
     }
 
-    // Go to a new line (force this to be the start of the line)
-    usb_serial_putchar('\r');
-    usb_serial_putchar('\n');
+    case 3:
+      end = fmt_str_P(buff, PSTR("Frame overruns: "));
+      end = fmt_uint(end, frame_overruns, 0, ' ');
+      end = fmt_str_P(end, PSTR(", render skips: "));
+      fmt_uint(end, render_skips, 0, ' ');
+      break;
+
+    case 4:
+      // 128us per tick, shown in ms
+      end = fmt_str_P(buff, PSTR("Max input latency: "));
+      end = fmt_fixed(end, (uint32_t) max_input_latency * 128 / 100, 1, 0);
+      end = fmt_str_P(end, PSTR("ms, dropped: "));
+      fmt_uint(end, input_queue_dropped, 0, ' ');
+      max_input_latency = 0;
+      break;
+
+#if ENABLE_PROFILING
+    case 5:
+      // worst case cycles per span, show_screen also per lcd_write
+      end = fmt_str_P(buff, PSTR("Cycles"));
+
+      for (unsigned char i = 0; i < PROF_NUM_SLOTS; i++)
+      {
+        end = fmt_char(end, ' ');
+        end = fmt_char(end, pgm_read_byte(&prof_names[i]));
+        end = fmt_char(end, ':');
+        end = fmt_uint(end, profile_max[i], 0, ' ');
+        if (i == PROF_SHOW) end = fmt_uint(fmt_char(end, '/'), profile_max[i] / LCD_BUFFER_SIZE, 0, ' ');
+      }
+      break;
+
+    case 6:
+      // the spans reported on the line before, which start over now
+      if (profile_over_budget())
+      {
+        end = fmt_str_P(buff, PSTR("Over cycle budget:"));
+
+        for (unsigned char i = 0; i < PROF_NUM_SLOTS; i++)
+        {
+          if (!(profile_over_budget() & (1 << i))) continue;
+          end = fmt_char(end, ' ');
+          end = fmt_char(end, pgm_read_byte(&prof_names[i]));
+          end = fmt_char(end, '>');
+          end = fmt_uint(end, profile_budget(i), 0, ' ');
+        }
+      }
+
+      profile_reset();
+      if (end == buff) return;
+      break;
+#endif
+  }
+
+  send_debug_string(buff);
 }
 
 void init()
@@ -235,12 +396,21 @@ void init()
   // overflow interrupt
   BIT_ON(TIMSK1, TOIE1);
 
-  // USB
+  // timer3 - cycle counter for profiling
+  profile_init();
+
+  // USB (simavr has no host to enumerate with)
+#if !ENABLE_BENCH
   usb_init();
+#endif
 
   // enable interrupts
   sei();
 
+  // frame pacing
+  frame_init();
+  timer_wheel_init(ticks_now());
+
   // ADC
 
   ADMUX = 0;
@@ -281,25 +451,32 @@ void init()
 
 void display_intro()
 {
-  draw_string(10, 0, "Alien Advance");
-  draw_string(9, 12, "Michael Ebens");
-  draw_string(22, 20, "n9732080");
-  draw_string(7, 32, "Press a button");
-  draw_string(7, 40, "to continue...");
+  draw_string_P(10, 0, PSTR("Alien Advance"));
+  draw_string_P(9, 12, PSTR("Michael Ebens"));
+  draw_string_P(22, 20, PSTR("n9732080"));
+  draw_string_P(7, 32, PSTR("Press a button"));
+  draw_string_P(7, 40, PSTR("to continue..."));
 }
 
 void draw_border()
 {
-  draw_line(0, 8, 0, 47); // left
-  draw_line(0, 8, 83, 8); // top
-  draw_line(83, 8, 83, 47); // right
-  draw_line(0, 47, 83, 47); // bottom
+  fill_rect(0, 8, 1, 40); // left
+  fill_rect(0, 8, 84, 1); // top
+  fill_rect(83, 8, 1, 40); // right
+  fill_rect(0, 47, 84, 1); // bottom
 }
 
 void draw_status()
 {
-  unsigned char mins = floor(time / 60);
-  sprintf(buff, "S:%d L:%d T:%02d:%02d", score, lives, mins, (unsigned char) floor(time - mins * 60));
+  uint32_t secs = ticks_to_ms(ticks_since(round_start, frame_ticks)) / 1000;
+  char* end = fmt_str_P(buff, PSTR("S:"));
+  end = fmt_uint(end, score, 0, ' ');
+  end = fmt_str_P(end, PSTR(" L:"));
+  end = fmt_uint(end, lives, 0, ' ');
+  end = fmt_str_P(end, PSTR(" T:"));
+  end = fmt_uint(end, secs / 60, 2, '0');
+  end = fmt_char(end, ':');
+  fmt_uint(end, secs % 60, 2, '0');
   draw_string(0, 0, buff);
 }
 
@@ -309,8 +486,8 @@ void find_empty_position(unsigned char* x, unsigned char* y, unsigned char width
 
   while (1)
   {
-    *x = 1 + (82 - width) * (((float) rand()) / RAND_MAX);
-    *y = 9 + (38 - height) * (((float) rand()) / RAND_MAX);
+    *x = 1 + rng_below(82 - width);
+    *y = 9 + rng_below(38 - height);
     okay = 1;
 
     if (check_player && !(*x >= player.x + PWIDTH + 2 || *x + width <= player.x - 2 || *y >= player.y + PHEIGHT + 2 || *y + height <= player.y - 2))
@@ -335,6 +512,12 @@ void find_empty_position(unsigned char* x, unsigned char* y, unsigned char width
   }
 }
 
+// 2 to 4 seconds between AI moves and shots
+uint32_t ai_delay()
+{
+  return TICKS_MS(2000) + rng_below(TICKS_MS(2000) + 1);
+}
+
 void reset_enemies(unsigned char check_player)
 {
   // reset all enemies to top, so they don't interfere when finding empty positions
@@ -353,17 +536,62 @@ void reset_enemies(unsigned char check_player)
     enemies[i].x = x;
     enemies[i].y = y;
     enemies[i].is_visible = 1;
-    enemy_timers[i] = 2 + 2 * (((float) rand()) / RAND_MAX);
+    timer_set(TIMER_ENEMY(i), frame_ticks + ai_delay());
   }
 
   enemies_alive = NUM_ENEMIES;
 }
 
-float get_shooting_angle()
+// called by sap_sweep() for a missile and an enemy whose x extents
+// overlap this frame
+void missile_meets_enemy(unsigned char i, unsigned char body)
 {
-  BIT_ON(ADCSRA, ADSC); // start conversion
-  while (GET_BIT(ADCSRA, ADSC));  // wait until complete
-  return ((float) ADC) / 1023 * PI * 4;
+  unsigned char j = body - NUM_MISSILES;
+  Sweep* path = &missile_paths[i];
+
+  if (!missiles[i].is_visible || !enemies[j].is_visible) return;
+  if (!sweep_hits(path, FIX8(enemies[j].x), FIX8(enemies[j].y), EWIDTH, EHEIGHT) || !sweep_overlaps(path, &enemies[j])) return;
+
+  missiles[i].is_visible = 0;
+  enemies[j].is_visible = 0;
+  enemies[j].dx = 0;
+  enemies[j].dy = 0;
+  enemies_alive--;
+  score++;
+  send_debug_string_P(PSTR("Player killed an alien"));
+
+  // SWITCH TO MOTHERSHIP BATTLE
+
+  if (enemies_alive <= 0)
+  {
+    mothership_battle = 1;
+    mothership.is_visible = 1;
+    mothership.dx = 0;
+    mothership.dy = 0;
+    timer_set(TIMER_MOTHER_MOVE, frame_ticks + ai_delay());
+    timer_set(TIMER_MOTHER_SHOOT, frame_ticks + ai_delay());
+    mother_health = MOTHER_MAX_HEALTH;
+
+    unsigned char okay = 1;
+    unsigned char x;
+    unsigned char y;
+
+    while (1)
+    {
+      x = 1 + rng_below(82 - MSWIDTH);
+      y = 9 + rng_below(38 - MSHEIGHT);
+
+      if (!(x >= player.x + PWIDTH + 2 || x + MSWIDTH <= player.x - 2 || y >= player.y + PHEIGHT + 2 || y + MSHEIGHT <= player.y - 2))
+      {
+        okay = 0;
+      }
+
+      if (okay) break;
+    }
+
+    mothership.x = x;
+    mothership.y = y;
+  }
 }
 
 int main(void)
@@ -375,66 +603,87 @@ int main(void)
   while (1)
   {
     // calculate delta time
-    DT = get_system_clock() - last_clock;
-    if (DT < 0) DT += TIMER1_OVERFLOW;
-    last_clock = get_system_clock();
+    uint32_t now = ticks_now();
+    DT = (uint16_t) ticks_since(frame_ticks, now) * TICK_SECONDS;
+    frame_ticks = now;
+    timer_wheel_advance(frame_ticks);
+
+    uint32_t frame_cycles = profile_cycles();
 
-    // random seed by measuring the time taken to the first button press
-    if (first_input_time != -1)
+    PROFILE(PROF_INPUT, drain_input_events(); console_poll((uint16_t) ticks_now()));
+
+    if (CONSOLE_WAS_PRESSED(CONSOLE_MIRROR))
     {
-      first_input_time += DT;
+      if (mirror_enabled)
+      {
+        mirror_stop();
+      }
+      else
+      {
+        mirror_start();
+      }
+    }
 
-      for (unsigned char i = 0; i < NUM_BUTTONS; i++)
+    // random seed by measuring the time taken to the first button
+    // press, unless a fixed seed is configured for replaying a run
+    if (!rng_seeded)
+    {
+      // center is active by default at startup
+      if (RNG_SEED || (btn_states & ~BTN_MASK(BTN_DPAD_CENTER)))
       {
-        if (i == BTN_DPAD_CENTER) continue; // this'll be active by default at startup
+        rng_seed(RNG_SEED ? RNG_SEED : frame_ticks);
+        rng_seeded = 1;
 
-        if (btn_states[i] == BTN_STATE_DOWN)
-        {
-          srand(first_input_time);
-          first_input_time = -1;
-        }
+        char* end = fmt_str_P(buff, PSTR("Seed: "));
+        fmt_hex(end, rng_seed_value, 8);
+        send_debug_string(buff);
       }
     }
 
-    if (light_timer > 0)
+    if (timer_armed(TIMER_LIGHT))
     {
       BIT_ON(PORTB, 2);
       BIT_ON(PORTB, 3);
-      light_timer -= DT;
-
-      if (light_timer <= 0)
-      {
-        BIT_OFF(PORTB, 2);
-        BIT_OFF(PORTB, 3);
-      }
+    }
+    else if (timer_expired(TIMER_LIGHT))
+    {
+      BIT_OFF(PORTB, 2);
+      BIT_OFF(PORTB, 3);
+      timer_cancel(TIMER_LIGHT);
     }
 
-    clear_screen();
+    uint32_t game_cycles = profile_cycles();
+    if (render_frame) clear_screen();
 
     if (GAME_STATE == -1)
     {
-      draw_string(14, 15, "Waiting for");
-      draw_string(7, 26, "USB connection");
+      draw_string_P(14, 15, PSTR("Waiting for"));
+      draw_string_P(7, 26, PSTR("USB connection"));
       show_screen();
-      while(!usb_configured() || !usb_serial_get_control());
+      while (!usb_configured() || !usb_serial_get_control()) frame_idle();
+      frame_begin();
 
       clear_screen();
-      draw_string(7, 20, "USB connected!");
+      draw_string_P(7, 20, PSTR("USB connected!"));
       show_screen();
       GAME_STATE = 0;
-      send_debug_string("Greetings! You are connected via USB to Alien Advance.");
-      send_debug_string("Use the WASD keys to move player and press space to shoot.");
-      _delay_ms(500);
+      send_debug_string_P(PSTR("Greetings! You are connected via USB to Alien Advance."));
+      send_debug_string_P(PSTR("Use the WASD keys to move player and press space to shoot."));
+      frame_wait(FRAME_MS(500));
+
+      // waiting for the host isn't a frame, keep it out of the profile
+      // and the overrun count
+      continue;
     }
     else if (GAME_STATE == 0)
     {
       display_intro();
 
-      if (input_timer > 0)
+      if (!timer_expired(TIMER_INPUT))
       {
-        input_timer -= DT;
+        // waiting out the delay after game over
       }
-      else if (btn_states[BTN_LEFT] == BTN_STATE_DOWN || btn_states[BTN_RIGHT] == BTN_STATE_DOWN)
+      else if (BTN_IS_DOWN(BTN_LEFT) || BTN_IS_DOWN(BTN_RIGHT))
       {
         GAME_STATE = 1;
         countdown = 4;
@@ -452,11 +701,11 @@ int main(void)
         // ROUND INITIALISATION
 
         GAME_STATE = 2;
-        time = 0;
+        round_start = frame_ticks;
         score = 0;
         lives = 5;
         mothership_battle = 0;
-        last_clock = get_system_clock();
+        console_reset();
 
         reset_enemies(0);
         mothership.is_visible = 0;
@@ -476,61 +725,23 @@ int main(void)
         }
       }
 
-      sprintf(buff, "%1d", countdown);
+      fmt_uint(buff, countdown, 1, ' ');
       draw_string(39, 20, buff);
     }
     else if (GAME_STATE == 2)
     {
-      time += DT;
-      float player_angle = get_shooting_angle();
+      uint8_t player_direction;
+      Aim player_aim;
+      PROFILE(PROF_AIM, player_direction = aim_read());
+      aim_get(player_direction, &player_aim);
 
-      if (debug_timer > 0)
-      {
-        debug_timer -= DT;
-      }
-      else
+      if (timer_expired(TIMER_DEBUG))
       {
-        sprintf(buff, "Player's current position: (%d, %d)", (unsigned char) player.x, (unsigned char) player.y);
-        send_debug_string(buff);
-        sprintf(buff, "Player's current aim: %.1f", player_angle * (180 / PI));
-        send_debug_string(buff);
-        debug_timer = 0.5;
+        report_line = 0;
+        timer_set(TIMER_DEBUG, frame_ticks + TICKS_MS(500));
       }
 
-      usb_left = 0;
-      usb_right = 0;
-      usb_up = 0;
-      usb_down = 0;
-      usb_shoot = 0;
-      int16_t usb_char = usb_serial_getchar();
-
-      while (usb_char != -1)
-      {
-        switch (usb_char)
-        {
-          case 'a':
-            usb_left = 1;
-            break;
-
-          case 'd':
-            usb_right = 1;
-            break;
-
-          case 'w':
-            usb_up = 1;
-            break;
-
-          case 's':
-            usb_down = 1;
-            break;
-
-          case ' ':
-            usb_shoot = 1;
-            break;
-        }
-
-        usb_char = usb_serial_getchar();
-      }
+      if (report_line < REPORT_LINES) send_report_line(report_line++, player_direction);
 
       if (mothership_battle)
       {
@@ -538,11 +749,7 @@ int main(void)
 
         unsigned char end_path = 0;
 
-        if (mother_move_timer > 0)
-        {
-          mother_move_timer -= DT;
-        }
-        else
+        if (timer_expired(TIMER_MOTHER_MOVE))
         {
           if (!mothership.dx)
           {
@@ -577,20 +784,23 @@ int main(void)
           }
         }
 
-        draw_sprite(&mothership);
+        if (render_frame) PROFILE(PROF_SPRITE, draw_sprite(&mothership));
 
-        unsigned char health_x = mothership.x + floor((MSWIDTH - 1) * ((float) mother_health / MOTHER_MAX_HEALTH));
-        unsigned char health_y = mothership.y < 14 ? mothership.y + MSHEIGHT + 1 : mothership.y - 3;
+        if (render_frame)
+        {
+          unsigned char health_x = mothership.x + floor((MSWIDTH - 1) * ((float) mother_health / MOTHER_MAX_HEALTH));
+          unsigned char health_y = mothership.y < 14 ? mothership.y + MSHEIGHT + 1 : mothership.y - 3;
 
-        draw_line(mothership.x, health_y,  health_x, health_y); 
-        draw_line(mothership.x, health_y + 1, health_x, health_y + 1); 
+          fill_rect(mothership.x, health_y, health_x - (unsigned char) mothership.x + 1, 2);
+        }
 
         if (!(mothership.x >= player.x + PWIDTH || mothership.x + MSWIDTH <= player.x
-            || mothership.y >= player.y + PHEIGHT || mothership.y + MSHEIGHT <= player.y))
+            || mothership.y >= player.y + PHEIGHT || mothership.y + MSHEIGHT <= player.y)
+            && sprites_overlap(&mothership, &player))
         {
-          if (mother_move_timer <= 0) end_path = 1;
+          if (timer_expired(TIMER_MOTHER_MOVE)) end_path = 1;
           lives--;
-          send_debug_string("Mothership destroyed the player");
+          send_debug_string_P(PSTR("Mothership destroyed the player"));
 
           if (lives <= 0)
           {
@@ -603,7 +813,7 @@ int main(void)
             find_empty_position(&x, &y, PWIDTH, PHEIGHT, 0);
             player.x = x;
             player.y = y;
-            light_timer = 0.5;
+            timer_set(TIMER_LIGHT, frame_ticks + TICKS_MS(500));
           }
         }
 
@@ -611,14 +821,10 @@ int main(void)
         {
           mothership.dx = 0;
           mothership.dy = 0;
-          mother_move_timer = 2 + 2 * (((float) rand()) / RAND_MAX); 
+          timer_set(TIMER_MOTHER_MOVE, frame_ticks + ai_delay());
         }
 
-        if (mother_shoot_timer > 0)
-        {
-          mother_shoot_timer -= DT;
-        }
-        else if (!mother_missile.is_visible)
+        if (timer_expired(TIMER_MOTHER_SHOOT) && !mother_missile.is_visible)
         {
           float angle = atan2(player.y + PHEIGHT / 2 - (mothership.y + MSHEIGHT / 2), player.x + PWIDTH / 2 - (mothership.x + MSWIDTH / 2));
           mother_missile.x = mothership.x + MSWIDTH / 2 + 4 * cos(angle);
@@ -626,26 +832,22 @@ int main(void)
           mother_missile.dx = 10 * cos(angle);
           mother_missile.dy = 10 * sin(angle);
           mother_missile.is_visible = 1;
-          mother_shoot_timer = 2 + 2 * (((float) rand()) / RAND_MAX);
+          timer_set(TIMER_MOTHER_SHOOT, frame_ticks + ai_delay());
         }
 
         if (mother_missile.is_visible)
         {
+          Sweep path = { FIX8(mother_missile.x), FIX8(mother_missile.y), 0, 0, MWIDTH, MHEIGHT, missile_bitmap };
           mother_missile.x += mother_missile.dx * DT;
           mother_missile.y += mother_missile.dy * DT;
+          path.dx = FIX8(mother_missile.x) - path.x;
+          path.dy = FIX8(mother_missile.y) - path.y;
 
-          if (mother_missile.x < 1 || mother_missile.x > 83 - MWIDTH || mother_missile.y < 9 || mother_missile.y > 47 - MHEIGHT)
-          {
-            mother_missile.is_visible = 0;
-            continue;
-          }
-
-          if (!(mother_missile.x >= player.x + PWIDTH || mother_missile.x + MWIDTH <= player.x
-              || mother_missile.y >= player.y + PHEIGHT || mother_missile.y + MHEIGHT <= player.y))
+          if (sweep_hits(&path, FIX8(player.x), FIX8(player.y), PWIDTH, PHEIGHT) && sweep_overlaps(&path, &player))
           {
             mother_missile.is_visible = 0;
             lives--;
-            send_debug_string("Mothership destroyed the player");
+            send_debug_string_P(PSTR("Mothership destroyed the player"));
 
             if (lives <= 0)
             {
@@ -658,30 +860,45 @@ int main(void)
               find_empty_position(&x, &y, PWIDTH, PHEIGHT, 0);
               player.x = x;
               player.y = y;
-              light_timer = 0.5;
+              timer_set(TIMER_LIGHT, frame_ticks + TICKS_MS(500));
             }
           }
 
-          draw_sprite(&mother_missile);
+          // after the hit test, which covers the path up to the edge
+          if (mother_missile.x < 1 || mother_missile.x > 83 - MWIDTH || mother_missile.y < 9 || mother_missile.y > 47 - MHEIGHT)
+          {
+            mother_missile.is_visible = 0;
+          }
+          else if (render_frame)
+          {
+            PROFILE(PROF_SPRITE, draw_sprite(&mother_missile));
+          }
         }
       }
       else
       {
         // enemies
+        // Re-aiming (atan2, cos and sin) is rationed to
+        // AI_DECISIONS_PER_FRAME, and the loop starts from ai_next so
+        // enemies left waiting get the first pick on the next frame.
+        // Moving along a path already chosen isn't rationed.
+
+        uint32_t enemy_cycles = profile_cycles();
+        unsigned char ai_budget = AI_DECISIONS_PER_FRAME;
+        unsigned char i = ai_next;
 
-        for (unsigned char i = 0; i < NUM_ENEMIES; i++)
+        for (unsigned char n = 0; n < NUM_ENEMIES; n++, i = i + 1 < NUM_ENEMIES ? i + 1 : 0)
         {
           if (!enemies[i].is_visible) continue;
           unsigned char end_path = 0;
 
-          if (enemy_timers[i] > 0)
-          {
-            enemy_timers[i] -= DT;
-          }
-          else
+          if (timer_expired(TIMER_ENEMY(i)) && (enemies[i].dx || ai_budget))
           {
             if (!enemies[i].dx)
             {
+              ai_budget--;
+              ai_next = i + 1 < NUM_ENEMIES ? i + 1 : 0;
+
               float angle = atan2(player.y + PHEIGHT / 2 - (enemies[i].y + EHEIGHT / 2), player.x + PWIDTH / 2 - (enemies[i].x + EWIDTH / 2));
               enemies[i].dx = 4 * cos(angle);
               enemies[i].dy = 4 * sin(angle);
@@ -714,11 +931,12 @@ int main(void)
           }
 
           if (!(enemies[i].x >= player.x + PWIDTH || enemies[i].x + EWIDTH <= player.x
-              || enemies[i].y >= player.y + PHEIGHT || enemies[i].y + EHEIGHT <= player.y))
+              || enemies[i].y >= player.y + PHEIGHT || enemies[i].y + EHEIGHT <= player.y)
+              && sprites_overlap(&enemies[i], &player))
           {
-            if (enemy_timers[i] <= 0) end_path = 1;
+            if (timer_expired(TIMER_ENEMY(i))) end_path = 1;
             lives--;
-            send_debug_string("Alien killed the player");
+            send_debug_string_P(PSTR("Alien killed the player"));
 
             if (lives <= 0)
             {
@@ -731,7 +949,7 @@ int main(void)
               find_empty_position(&x, &y, PWIDTH, PHEIGHT, 0);
               player.x = x;
               player.y = y;
-              light_timer = 0.5;
+              timer_set(TIMER_LIGHT, frame_ticks + TICKS_MS(500));
             }
           }
 
@@ -739,11 +957,13 @@ int main(void)
           {
             enemies[i].dx = 0;
             enemies[i].dy = 0;
-            enemy_timers[i] = 2 + 2 * (((float) rand()) / RAND_MAX); 
+            timer_set(TIMER_ENEMY(i), frame_ticks + ai_delay());
           }
 
-          draw_sprite(&enemies[i]);
+          if (render_frame) PROFILE(PROF_SPRITE, draw_sprite(&enemies[i]));
         }
+
+        profile_add(PROF_ENEMIES, profile_cycles() - enemy_cycles);
       }
       
       // player
@@ -751,10 +971,10 @@ int main(void)
       char x_axis = 0;
       char y_axis = 0;
 
-      if (btn_states[BTN_DPAD_LEFT] == BTN_STATE_DOWN || usb_left) x_axis--;
-      if (btn_states[BTN_DPAD_RIGHT] == BTN_STATE_DOWN || usb_right) x_axis++;
-      if (btn_states[BTN_DPAD_UP] == BTN_STATE_DOWN || usb_up) y_axis--;
-      if (btn_states[BTN_DPAD_DOWN] == BTN_STATE_DOWN || usb_down) y_axis++;
+      if (BTN_IS_DOWN(BTN_DPAD_LEFT) || CONSOLE_IS_DOWN(CONSOLE_LEFT)) x_axis--;
+      if (BTN_IS_DOWN(BTN_DPAD_RIGHT) || CONSOLE_IS_DOWN(CONSOLE_RIGHT)) x_axis++;
+      if (BTN_IS_DOWN(BTN_DPAD_UP) || CONSOLE_IS_DOWN(CONSOLE_UP)) y_axis--;
+      if (BTN_IS_DOWN(BTN_DPAD_DOWN) || CONSOLE_IS_DOWN(CONSOLE_DOWN)) y_axis++;
 
       if (x_axis != 0)
       {
@@ -770,23 +990,19 @@ int main(void)
         if (player.y > 47 - PHEIGHT) player.y = 47 - PHEIGHT;
       }
 
-      char x2 = player.x + PWIDTH / 2 + 6 * cos(player_angle);
-      char y2 = player.y + PHEIGHT / 2 + 6 * sin(player_angle);
-      if (x2 < 1) x2 = 1;
-      if (x2 > 83) x2 = 83;
-      if (y2 < 9) y2 = 9;
-      if (y2 > 47) y2 = 47;
-      draw_line(player.x + PWIDTH / 2, player.y + PHEIGHT / 2, x2, y2);
+      if (render_frame)
+      {
+        aim_draw(&player_aim, player.x + PWIDTH / 2, player.y + PHEIGHT / 2);
+      }
       
-      draw_sprite(&player);
+      if (render_frame) PROFILE(PROF_SPRITE, draw_sprite(&player));
 
       // missiles
 
       unsigned char fire_missile = 0;
 
-      if (btn_right_pressed || usb_shoot)
+      if (btn_right_presses || CONSOLE_WAS_PRESSED(CONSOLE_SHOOT))
       {
-        btn_right_pressed = 0;
         fire_missile = 1;
       }
 
@@ -794,20 +1010,22 @@ int main(void)
       {
         if (missiles[i].is_visible)
         {
+          // hits are tested along the whole path moved this frame
+          Sweep* path = &missile_paths[i];
+          *path = (Sweep) { FIX8(missiles[i].x), FIX8(missiles[i].y), 0, 0, MWIDTH, MHEIGHT, missile_bitmap };
           missiles[i].x += missiles[i].dx * DT;
           missiles[i].y += missiles[i].dy * DT;
-          draw_sprite(&missiles[i]);
+          path->dx = FIX8(missiles[i].x) - path->x;
+          path->dy = FIX8(missiles[i].y) - path->y;
+          if (render_frame) PROFILE(PROF_SPRITE, draw_sprite(&missiles[i]));
 
-          if (missiles[i].x < 1 || missiles[i].x > 83 - MWIDTH || missiles[i].y < 9 || missiles[i].y > 47 - MHEIGHT)
-          {
-            missiles[i].is_visible = 0;
-            continue;
-          }
+          // x extent of the path for the enemy broadphase below
+          int16_t left = path->dx < 0 ? path->x + path->dx : path->x;
+          sap_set(i, left, left + (path->dx < 0 ? -path->dx : path->dx) + (MWIDTH << 8));
 
           if (mothership_battle)
           {
-            if (!(missiles[i].x >= mothership.x + MSWIDTH || missiles[i].x + MWIDTH <= mothership.x ||
-                  missiles[i].y >= mothership.y + MSHEIGHT || missiles[i].y + MHEIGHT <= mothership.y))
+            if (sweep_hits(path, FIX8(mothership.x), FIX8(mothership.y), MSWIDTH, MSHEIGHT) && sweep_overlaps(path, &mothership))
             {
               missiles[i].is_visible = 0;
               mother_health--;
@@ -816,7 +1034,7 @@ int main(void)
 
               if (mother_health <= 0)
               {
-                send_debug_string("Player destroyed the mothership");
+                send_debug_string_P(PSTR("Player destroyed the mothership"));
                 mothership_battle = 0;
                 score += 10;
                 reset_enemies(1);
@@ -824,101 +1042,116 @@ int main(void)
               }
             }
           }
-          else
+        }
+        else
+        {
+          sap_remove(i);
+
+          if (fire_missile)
           {
-            for (unsigned char j = 0; j < NUM_ENEMIES; j++)
-            {
-              if (!enemies[j].is_visible) continue;
+            missiles[i].x = player.x + PWIDTH / 2 + player_aim.launch_x * (1.0 / 256);
+            missiles[i].y = player.y + PHEIGHT / 2 + player_aim.launch_y * (1.0 / 256);
+            missiles[i].dx = player_aim.speed_x * (1.0 / 256);
+            missiles[i].dy = player_aim.speed_y * (1.0 / 256);
+            missiles[i].is_visible = 1;
+            fire_missile = 0;
+          }
+        }
+      }
 
-              if (!(missiles[i].x >= enemies[j].x + EWIDTH || missiles[i].x + MWIDTH <= enemies[j].x ||
-                    missiles[i].y >= enemies[j].y + EHEIGHT || missiles[i].y + MHEIGHT <= enemies[j].y))
-              {
-                missiles[i].is_visible = 0;
-                enemies[j].is_visible = 0;
-                enemies[j].dx = 0;
-                enemies[j].dy = 0;
-                enemies_alive--;
-                score++;
-                send_debug_string("Player killed an alien");
-
-                // SWITCH TO MOTHERSHIP BATTLE
-
-                if (enemies_alive <= 0)
-                {
-                  mothership_battle = 1;
-                  mothership.is_visible = 1;
-                  mothership.dx = 0;
-                  mothership.dy = 0;
-                  mother_move_timer = 2 + 2 * (((float) rand()) / RAND_MAX);
-                  mother_shoot_timer = 2 + 2 * (((float) rand()) / RAND_MAX);
-                  mother_health = MOTHER_MAX_HEALTH;
-
-                  unsigned char okay = 1;
-                  unsigned char x;
-                  unsigned char y;
-
-                  while (1)
-                  {
-                    x = 1 + (82 - MSWIDTH) * (((float) rand()) / RAND_MAX);
-                    y = 9 + (38 - MSHEIGHT) * (((float) rand()) / RAND_MAX);
-
-                    if (!(x >= player.x + PWIDTH + 2 || x + MSWIDTH <= player.x - 2 || y >= player.y + PHEIGHT + 2 || y + MSHEIGHT <= player.y - 2))
-                    {
-                      okay = 0;
-                    }
-
-                    if (okay) break;
-                  }
-
-                  mothership.x = x;
-                  mothership.y = y;
-                }
-              }
-            }
+      // missiles against enemies, only for pairs whose x extents overlap
+      if (!mothership_battle)
+      {
+        for (unsigned char j = 0; j < NUM_ENEMIES; j++)
+        {
+          if (enemies[j].is_visible)
+          {
+            int16_t left = FIX8(enemies[j].x);
+            sap_set(NUM_MISSILES + j, left, left + (EWIDTH << 8));
+          }
+          else
+          {
+            sap_remove(NUM_MISSILES + j);
           }
         }
-        else if (fire_missile)
+
+        sap_sort();
+        sap_sweep(NUM_MISSILES, missile_meets_enemy);
+      }
+
+      // after the hit tests, which cover the path up to the edge
+      for (unsigned char i = 0; i < NUM_MISSILES; i++)
+      {
+        if (missiles[i].x < 1 || missiles[i].x > 83 - MWIDTH || missiles[i].y < 9 || missiles[i].y > 47 - MHEIGHT)
         {
-          missiles[i].x = player.x + PWIDTH / 2 + 2 * cos(player_angle);
-          missiles[i].y = player.y + PHEIGHT / 2 + 2 * sin(player_angle);
-          missiles[i].dx = 10 * cos(player_angle);
-          missiles[i].dy = 10 * sin(player_angle);
-          missiles[i].is_visible = 1;
-          fire_missile = 0;
+          missiles[i].is_visible = 0;
         }
       }
 
       // border/status
 
-      draw_border();
-      draw_status();
+      if (render_frame)
+      {
+        draw_border();
+        draw_status();
+      }
     }
     else if (GAME_STATE == 3)
     {
-      draw_string(19, 8, "GAME OVER");
-      draw_string(0, 20, "Would you like");
-      draw_string(0, 28, "to play again?");
-      draw_string(0, 38, "Press a button...");
+      draw_string_P(19, 8, PSTR("GAME OVER"));
+      draw_string_P(0, 20, PSTR("Would you like"));
+      draw_string_P(0, 28, PSTR("to play again?"));
+      draw_string_P(0, 38, PSTR("Press a button..."));
 
-      if (btn_states[BTN_LEFT] == BTN_STATE_DOWN || btn_states[BTN_RIGHT] == BTN_STATE_DOWN)
+      if (BTN_IS_DOWN(BTN_LEFT) || BTN_IS_DOWN(BTN_RIGHT))
       {
         GAME_STATE = 0;
 
         // ensures the game doesn't instantly start from the intro screen
-        input_timer = 0.5;
+        timer_set(TIMER_INPUT, frame_ticks + TICKS_MS(500));
       }
     }
 
-    show_screen();
+    profile_add(PROF_GAME, profile_cycles() - game_cycles);
+
+    if (render_frame)
+    {
+      PROFILE(PROF_SHOW, show_screen());
+      PROFILE(PROF_MIRROR, mirror_screen());
+    }
+
+    profile_add(PROF_FRAME, profile_cycles() - frame_cycles);
+
+    unsigned char overran;
 
     if (GAME_STATE == 1)
     {
-      _delay_ms(300);
+      overran = frame_wait(FRAME_MS(300));
+    }
+    else
+    {
+      overran = frame_wait(FRAME_MS(10));
+    }
+
+    // when a frame runs over, drawing is skipped for the next one (but
+    // the game still updates), unless too many have been skipped in a row
+    if (overran) frame_overruns++;
+
+    if (overran && skipped_in_row < MAX_SKIPPED_RENDERS)
+    {
+      render_frame = 0;
+      render_skips++;
+      skipped_in_row++;
     }
     else
     {
-      _delay_ms(10);
+      render_frame = 1;
+      skipped_in_row = 0;
     }
+
+#if ENABLE_BENCH
+    bench_frame();
+#endif
   }
 
   return 0;
@@ -926,51 +1159,37 @@ int main(void)
 
 ISR(TIMER0_COMPA_vect)
 {
-  for (unsigned char i = 0; i < NUM_BUTTONS; i++)
+  unsigned char pinb = PINB;
+  unsigned char pind = PIND;
+  unsigned char pinf = PINF;
+
+  // pack all buttons into one byte, bit n = button n
+  unsigned char sample =
+    ((pinb >> 1) & 0b00000001) | // PINB1 -> BTN_DPAD_LEFT
+    ((pind << 1) & 0b00000110) | // PIND0, PIND1 -> BTN_DPAD_RIGHT, BTN_DPAD_UP
+    ((pinb >> 4) & 0b00001000) | // PINB7 -> BTN_DPAD_DOWN
+    ((pinb << 4) & 0b00010000) | // PINB0 -> BTN_DPAD_CENTER
+    ((pinf >> 1) & 0b00100000) | // PINF6 -> BTN_LEFT
+    ((pinf << 1) & 0b01000000);  // PINF5 -> BTN_RIGHT
+
+  // buttons whose sample differs from the debounced state count down,
+  // the rest are reset, so a change needs 4 agreeing samples (12ms)
+  unsigned char states = btn_states;
+  unsigned char changed = states ^ sample;
+  btn_count0 = ~(btn_count0 & changed);
+  btn_count1 = btn_count0 ^ (btn_count1 & changed);
+  changed &= btn_count0 & btn_count1;
+
+  states ^= changed;
+  btn_states = states;
+
+  if (changed)
   {
-    unsigned char state = 0;
-
-    switch (i)
-    {
-      case BTN_DPAD_LEFT:
-        state = GET_BIT(PINB, 1);
-        break;
-      case BTN_DPAD_RIGHT:
-        state = GET_BIT(PIND, 0);
-        break;
-      case BTN_DPAD_UP:
-        state = GET_BIT(PIND, 1);
-        break;
-      case BTN_DPAD_DOWN:
-        state = GET_BIT(PINB, 7);
-        break;
-      case BTN_DPAD_CENTER:
-        state = GET_BIT(PINB, 0);
-        break;
-      case BTN_LEFT:
-        state = GET_BIT(PINF, 6);
-        break;
-      case BTN_RIGHT:
-        state = GET_BIT(PINF, 5);
-        break;
-    }
-
-    btn_hists[i] = btn_hists[i] << 1;
-    SET_BIT(btn_hists[i], 0, state);
+    uint16_t ticks = TCNT1;
 
-    if (btn_states[i] == BTN_STATE_DOWN && btn_hists[i] == 0x00)
+    for (unsigned char i = 0; i < NUM_BUTTONS; i++)
     {
-      btn_states[i] = BTN_STATE_UP;
-    }
-    else if (btn_states[i] == BTN_STATE_UP && btn_hists[i] == 0xFF)
-    {
-      btn_states[i] = BTN_STATE_DOWN;
-      if (i == BTN_RIGHT) btn_right_pressed = 1;
+      if (changed & BTN_MASK(i)) push_input_event(ticks, i, (states >> i) & 1);
     }
   }
 }
-
-ISR(TIMER1_OVF_vect)
-{
-  clock_overflow++;
-}
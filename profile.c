@@ -0,0 +1,69 @@
+// Alien Advance
+// Michael Ebens
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#include "profile.h"
+
+#if ENABLE_PROFILING
+
+uint32_t profile_max[PROF_NUM_SLOTS];
+
+static const uint32_t PROGMEM budgets[PROF_NUM_SLOTS] = PROF_BUDGETS;
+static volatile uint16_t profile_overflows = 0;
+static uint8_t over_budget = 0;
+
+_Static_assert(PROF_NUM_SLOTS <= 8, "over_budget has one bit per slot");
+
+void profile_init(void)
+{
+  // timer3 normal mode, no prescaler
+  TCCR3A = 0;
+  TCCR3B = (1 << CS30);
+  TIMSK3 |= (1 << TOIE3);
+}
+
+uint32_t profile_cycles(void)
+{
+  uint8_t intr_state = SREG;
+  cli();
+  uint16_t low = TCNT3;
+  uint16_t high = profile_overflows;
+
+  // the counter wrapped but the interrupt hasn't run yet
+  if ((TIFR3 & (1 << TOV3)) && low < 0x8000) high++;
+
+  SREG = intr_state;
+  return ((uint32_t) high << 16) | low;
+}
+
+void profile_add(uint8_t slot, uint32_t cycles)
+{
+  if (cycles > profile_max[slot]) profile_max[slot] = cycles;
+  if (cycles > pgm_read_dword(&budgets[slot])) over_budget |= (1 << slot);
+}
+
+uint8_t profile_over_budget(void)
+{
+  return over_budget;
+}
+
+uint32_t profile_budget(uint8_t slot)
+{
+  return pgm_read_dword(&budgets[slot]);
+}
+
+void profile_reset(void)
+{
+  for (uint8_t i = 0; i < PROF_NUM_SLOTS; i++) profile_max[i] = 0;
+  over_budget = 0;
+}
+
+ISR(TIMER3_OVF_vect)
+{
+  profile_overflows++;
+}
+
+#endif /* ENABLE_PROFILING */
@@ -0,0 +1,64 @@
+// Alien Advance
+// Michael Ebens
+
+// Cycle counting profiler. Timer3 runs at the CPU clock with an
+// overflow count on top, so profile_cycles() is an exact 32-bit cycle
+// count. Spans include any interrupts that ran inside them.
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+
+#include "config.h"
+
+// profiled spans
+#define PROF_FRAME 0  // busy part of the whole frame
+#define PROF_INPUT 1  // draining buttons and console
+#define PROF_GAME 2   // game state update and drawing
+#define PROF_SHOW 3   // show_screen (LCD_BUFFER_SIZE lcd_write calls)
+#define PROF_MIRROR 4 // mirror_screen
+#define PROF_SPRITE 5 // one draw_sprite call
+#define PROF_AIM 6    // one aim_read call (the pot's ADC conversion)
+#define PROF_ENEMIES 7 // enemy update including AI decisions
+#define PROF_NUM_SLOTS 8
+
+// one letter per slot for the debug report
+#define PROF_NAMES "FIGSMDAE"
+
+// worst case cycles allowed per span, 8000 cycles = 1ms
+#define PROF_BUDGETS { 80000, 8000, 60000, 40000, 16000, 4000, 8000, 24000 }
+
+#if ENABLE_PROFILING
+
+// worst case of each span since the last profile_reset()
+extern uint32_t profile_max[PROF_NUM_SLOTS];
+
+void profile_init(void);
+uint32_t profile_cycles(void);
+void profile_add(uint8_t slot, uint32_t cycles);
+
+// bit n set when slot n has gone over its budget since the last reset
+uint8_t profile_over_budget(void);
+uint32_t profile_budget(uint8_t slot);
+void profile_reset(void);
+
+#define PROFILE(slot, statement) \
+  do \
+  { \
+    uint32_t profile_start = profile_cycles(); \
+    statement; \
+    profile_add(slot, profile_cycles() - profile_start); \
+  } while (0)
+
+#else
+
+static inline void profile_init(void) {}
+static inline uint32_t profile_cycles(void) { return 0; }
+static inline void profile_add(uint8_t slot, uint32_t cycles) {}
+
+#define PROFILE(slot, statement) do { statement; } while (0)
+
+#endif /* ENABLE_PROFILING */
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,46 @@
+// Alien Advance
+// Michael Ebens
+
+#include "rng.h"
+
+// xorshift never leaves the all zero state, so that seed is swapped
+#define RNG_ZERO_SEED 2463534242UL
+
+uint32_t rng_seed_value = 0;
+static uint32_t rng_state = RNG_ZERO_SEED;
+
+void rng_seed(uint32_t seed)
+{
+  rng_seed_value = seed;
+  rng_state = seed ? seed : RNG_ZERO_SEED;
+}
+
+uint32_t rng_next(void)
+{
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+uint16_t rng_below(uint16_t bound)
+{
+  // Multiply 16 random bits by bound and keep the top half. The low
+  // half is below 65536 % bound for exactly the products that would
+  // make some results more likely, so those draws are retried.
+  uint32_t product = (rng_next() >> 16) * (uint32_t) bound;
+
+  if ((uint16_t) product < bound)
+  {
+    uint16_t threshold = (uint16_t) -bound % bound;
+
+    while ((uint16_t) product < threshold)
+    {
+      product = (rng_next() >> 16) * (uint32_t) bound;
+    }
+  }
+
+  return product >> 16;
+}
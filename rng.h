@@ -0,0 +1,26 @@
+// Alien Advance
+// Michael Ebens
+
+// Small integer random number generator (xorshift32), used in place of
+// rand() so that picking positions and AI delays needs no float
+// division. It is plain C with no AVR dependencies, so a run seeded
+// with the same value plays out identically on the host.
+
+#ifndef RNG_H_
+#define RNG_H_
+
+#include <stdint.h>
+
+// the seed passed to rng_seed(), kept so a run can be replayed
+extern uint32_t rng_seed_value;
+
+void rng_seed(uint32_t seed);
+
+// 32 uniformly distributed bits
+uint32_t rng_next(void);
+
+// uniformly distributed in [0, bound), without modulo bias; bound must
+// be at least 1
+uint16_t rng_below(uint16_t bound);
+
+#endif /* RNG_H_ */
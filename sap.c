@@ -0,0 +1,78 @@
+// Alien Advance
+// Michael Ebens
+
+#include "sap.h"
+
+// removed bodies sort to the end and are never swept
+#define SAP_REMOVED INT16_MAX
+
+static int16_t sap_left[SAP_BODIES];
+static int16_t sap_right[SAP_BODIES];
+
+// body numbers by left edge, starts out as 0, 1, 2, ...
+static uint8_t sap_order[SAP_BODIES];
+static uint8_t sap_ready = 0;
+
+void sap_set(uint8_t body, int16_t left, int16_t right)
+{
+  sap_left[body] = left;
+  sap_right[body] = right;
+}
+
+void sap_remove(uint8_t body)
+{
+  sap_left[body] = SAP_REMOVED;
+}
+
+void sap_sort(void)
+{
+  if (!sap_ready)
+  {
+    for (uint8_t i = 0; i < SAP_BODIES; i++) sap_order[i] = i;
+    sap_ready = 1;
+  }
+
+  for (uint8_t i = 1; i < SAP_BODIES; i++)
+  {
+    uint8_t body = sap_order[i];
+    int16_t left = sap_left[body];
+    uint8_t j = i;
+
+    while (j > 0 && sap_left[sap_order[j - 1]] > left)
+    {
+      sap_order[j] = sap_order[j - 1];
+      j--;
+    }
+
+    sap_order[j] = body;
+  }
+}
+
+void sap_sweep(uint8_t split, void (*overlap)(uint8_t a, uint8_t b))
+{
+  // bodies whose extents reach past the left edge being swept
+  uint8_t active[SAP_BODIES];
+  uint8_t num_active = 0;
+
+  for (uint8_t i = 0; i < SAP_BODIES; i++)
+  {
+    uint8_t body = sap_order[i];
+    int16_t left = sap_left[body];
+    if (left == SAP_REMOVED) break;
+
+    uint8_t kept = 0;
+
+    for (uint8_t k = 0; k < num_active; k++)
+    {
+      uint8_t other = active[k];
+      if (sap_right[other] <= left) continue; // ended, drop it
+      active[kept++] = other;
+
+      if (other < split && body >= split) overlap(other, body);
+      else if (body < split && other >= split) overlap(body, other);
+    }
+
+    active[kept++] = body;
+    num_active = kept;
+  }
+}
@@ -0,0 +1,34 @@
+// Alien Advance
+// Michael Ebens
+
+// Sweep and prune broadphase on x. Every body has an x extent, and the
+// bodies are kept in order of their left edges. Things only move a
+// little each frame, so the order is repaired with an insertion sort,
+// which is close to linear on a list that is nearly sorted already.
+// Sweeping the list left to right then only pairs up bodies whose
+// extents overlap, instead of testing every pair.
+//
+// Bodies below the split given to sap_sweep() are only paired with
+// bodies at or above it (missiles with enemies in main.c).
+
+#ifndef SAP_H_
+#define SAP_H_
+
+#include <stdint.h>
+
+#include "config.h"
+
+// extents are in 8.8 fixed point pixels (collide.h), and bodies that
+// only touch edge to edge don't overlap
+void sap_set(uint8_t body, int16_t left, int16_t right);
+
+// leave a body out of the sweep until it is set again
+void sap_remove(uint8_t body);
+
+// restore the order after bodies have moved
+void sap_sort(void);
+
+// call overlap(a, b) for every a < split <= b with overlapping extents
+void sap_sweep(uint8_t split, void (*overlap)(uint8_t a, uint8_t b));
+
+#endif /* SAP_H_ */
@@ -0,0 +1,205 @@
+// Alien Advance
+// Michael Ebens
+
+#include <string.h>
+
+#include <graphics.h>
+
+#include "screen_mirror.h"
+#include "usb_serial.h"
+
+#if ENABLE_SCREEN_MIRROR
+
+_Static_assert(TX_RING_SIZE >= MIRROR_TEXT_HEADROOM + MIRROR_MIN_PACKET, "MIRROR_TEXT_HEADROOM leaves no room for mirror packets");
+
+unsigned char mirror_enabled = 0;
+
+// screen contents as the host last saw them
+static unsigned char mirror_copy[LCD_BUFFER_SIZE];
+
+// where the next packet carries on from
+static uint16_t mirror_cursor = 0;
+
+// set until one complete pass has been sent after starting
+static unsigned char mirror_resync = 0;
+
+// where this frame's mirror_screen() call started
+static uint16_t mirror_frame_start = 0;
+
+// the host's copy matches a frame that was shown
+static unsigned char mirror_exact = 0;
+
+// set once this frame has reached the host, or didn't need to
+static unsigned char mirror_captured = 0;
+
+// frames shown since the last exact frame that never reached the host
+static unsigned char mirror_skipped = 0;
+
+#define CHANGED(i) (mirror_resync || screen_buffer[i] != mirror_copy[i])
+
+void mirror_start(void)
+{
+  mirror_enabled = 1;
+  mirror_resync = 1;
+  mirror_cursor = 0;
+  mirror_exact = 0;
+  mirror_skipped = 0;
+}
+
+void mirror_stop(void)
+{
+  mirror_enabled = 0;
+}
+
+// encode changes from mirror_cursor into one packet of at most space
+// bytes, returns the packet size (0 if there is nothing to send)
+static uint8_t encode_packet(uint8_t* packet, uint8_t space, unsigned char* frame_done)
+{
+  uint8_t* out = packet + MIRROR_HEADER_SIZE;
+  uint8_t* limit = packet + space;
+  uint16_t i = mirror_cursor;
+
+  *frame_done = 0;
+
+  while (1)
+  {
+    if (i == LCD_BUFFER_SIZE)
+    {
+      if (out == limit) break;
+
+      // nothing at all has changed, don't bother the host
+      if (mirror_cursor == 0 && out == packet + MIRROR_HEADER_SIZE && mirror_exact)
+      {
+        *frame_done = 1;
+        mirror_captured = 1;
+        return 0;
+      }
+
+      // bytes sent in earlier frames of this pass must still match
+      mirror_exact = !memcmp(mirror_copy, screen_buffer, mirror_frame_start);
+
+      if (mirror_exact)
+      {
+        *out++ = MIRROR_OP_FRAME | MIRROR_FRAME_EXACT | mirror_skipped;
+        mirror_captured = 1;
+        mirror_skipped = 0;
+      }
+      else
+      {
+        *out++ = MIRROR_OP_FRAME;
+      }
+
+      *frame_done = 1;
+      mirror_resync = 0;
+      i = 0;
+      break;
+    }
+
+    uint16_t n = 0;
+
+    // unchanged bytes, skipped entirely if they reach the end
+    while (i + n < LCD_BUFFER_SIZE && !CHANGED(i + n)) n++;
+
+    if (i + n == LCD_BUFFER_SIZE)
+    {
+      i = LCD_BUFFER_SIZE;
+      continue;
+    }
+
+    if (n)
+    {
+      if (n > MIRROR_MAX_COUNT) n = MIRROR_MAX_COUNT;
+      if (out == limit) break;
+      *out++ = MIRROR_OP_SKIP | (n - 1);
+      i += n;
+      continue;
+    }
+
+    // repeated bytes (whether changed or not)
+    unsigned char value = screen_buffer[i];
+    n = 1;
+    while (i + n < LCD_BUFFER_SIZE && n < MIRROR_MAX_COUNT && screen_buffer[i + n] == value) n++;
+
+    if (n >= 3)
+    {
+      if (limit - out < 2) break;
+      *out++ = MIRROR_OP_RUN | (n - 1);
+      *out++ = value;
+
+      for (; n; n--, i++) mirror_copy[i] = value;
+      continue;
+    }
+
+    // changed bytes up to the next unchanged byte or run
+    n = 0;
+    while (i + n < LCD_BUFFER_SIZE && n < MIRROR_MAX_COUNT && CHANGED(i + n))
+    {
+      if (i + n + 2 < LCD_BUFFER_SIZE && screen_buffer[i + n] == screen_buffer[i + n + 1]
+          && screen_buffer[i + n] == screen_buffer[i + n + 2]) break;
+      n++;
+    }
+
+    if (limit - out < 2) break;
+    if (n > limit - out - 1) n = limit - out - 1;
+    *out++ = MIRROR_OP_LITERAL | (n - 1);
+
+    for (; n; n--, i++)
+    {
+      mirror_copy[i] = screen_buffer[i];
+      *out++ = screen_buffer[i];
+    }
+  }
+
+  if (out == packet + MIRROR_HEADER_SIZE) return 0;
+
+  uint16_t length = out - packet - 4;
+  packet[0] = MIRROR_MAGIC0;
+  packet[1] = MIRROR_MAGIC1;
+  packet[2] = length & 0xFF;
+  packet[3] = length >> 8;
+  packet[4] = mirror_cursor & 0xFF;
+  packet[5] = mirror_cursor >> 8;
+
+  mirror_cursor = i;
+  return out - packet;
+}
+
+void mirror_screen(void)
+{
+  if (!mirror_enabled || !usb_configured()) return;
+
+  uint8_t packet[MIRROR_PACKET_SIZE];
+  unsigned char frame_done = 0;
+
+  mirror_frame_start = mirror_cursor;
+  mirror_captured = 0;
+
+  // packets go through a small buffer rather than straight into the
+  // transmit ring, so they can wrap around the end of the ring
+  while (!frame_done)
+  {
+    uint8_t free = usb_serial_tx_free();
+    uint8_t space = free > MIRROR_TEXT_HEADROOM ? free - MIRROR_TEXT_HEADROOM : 0;
+    if (space > MIRROR_PACKET_SIZE) space = MIRROR_PACKET_SIZE;
+
+    // not worth sending a packet this small, carry on next frame
+    if (space < MIRROR_MIN_PACKET)
+    {
+      // a frame identical to the last exact one needs nothing sent
+      if (mirror_cursor == 0 && mirror_exact && !memcmp(mirror_copy, screen_buffer, LCD_BUFFER_SIZE))
+      {
+        mirror_captured = 1;
+      }
+
+      break;
+    }
+
+    uint8_t size = encode_packet(packet, space, &frame_done);
+    if (!size) break;
+    usb_serial_tx_write(packet, size);
+  }
+
+  if (!mirror_captured && mirror_skipped < MIRROR_MAX_SKIPPED) mirror_skipped++;
+}
+
+#endif /* ENABLE_SCREEN_MIRROR */
@@ -0,0 +1,82 @@
+// Alien Advance
+// Michael Ebens
+
+// Mirrors screen_buffer to the host over the USB serial link, so the
+// LCD can be watched and recorded remotely (see tools/mirror_decode.c).
+//
+// Only bytes that changed since the last mirrored copy are sent,
+// run-length encoded, in packets interleaved with the debug text:
+//
+//   MIRROR_MAGIC0 MIRROR_MAGIC1 length(2) offset(2) ops...
+//
+// (16-bit values little endian, length counts the offset and ops)
+// Each op is one byte, the top two bits the type and the low six bits
+// the count minus one:
+//
+//   MIRROR_OP_SKIP     count bytes unchanged
+//   MIRROR_OP_RUN      count copies of the following byte
+//   MIRROR_OP_LITERAL  count bytes follow
+//   MIRROR_OP_FRAME    end of screen reached, see below
+//
+// A packet never has to hold a whole frame. The encoder stops when
+// only MIRROR_TEXT_HEADROOM bytes of the transmit ring are left, so
+// there's always room for a debug line, and carries on from that
+// offset next frame (at most one complete pass is sent per frame),
+// so mirroring never stalls the game loop; the host shows a frame
+// each time MIRROR_OP_FRAME arrives.
+//
+// A pass that ran over several frames can end with the host holding
+// the start of one frame and the rest of a later one. The frame op
+// only has MIRROR_FRAME_EXACT set when the host's copy matches a frame
+// that was actually shown, and then its low bits count the frames shown
+// since the last exact one that never made it over (up to
+// MIRROR_MAX_SKIPPED). Frames identical to the last exact one aren't
+// sent again. Recordings should keep only exact frames.
+
+#ifndef SCREEN_MIRROR_H_
+#define SCREEN_MIRROR_H_
+
+#include <stdint.h>
+
+#include "config.h"
+
+#define MIRROR_MAGIC0 0x1B // ESC, never in the debug text
+#define MIRROR_MAGIC1 'M'
+#define MIRROR_HEADER_SIZE 6
+#define MIRROR_PACKET_SIZE 64
+
+#define MIRROR_OP_SKIP 0x00
+#define MIRROR_OP_RUN 0x40
+#define MIRROR_OP_LITERAL 0x80
+#define MIRROR_OP_FRAME 0xC0
+#define MIRROR_OP_TYPE 0xC0
+#define MIRROR_MAX_COUNT 64
+
+#define MIRROR_FRAME_EXACT 0x20
+#define MIRROR_MAX_SKIPPED 0x1F
+
+// smallest packet worth sending
+#define MIRROR_MIN_PACKET (MIRROR_HEADER_SIZE + 8)
+
+#if ENABLE_SCREEN_MIRROR
+
+extern unsigned char mirror_enabled;
+
+// start mirroring, the first frame is sent in full
+void mirror_start(void);
+void mirror_stop(void);
+
+// send as much of the changes to screen_buffer as fits, call after
+// show_screen()
+void mirror_screen(void);
+
+#else
+
+#define mirror_enabled 0
+static inline void mirror_start(void) {}
+static inline void mirror_stop(void) {}
+static inline void mirror_screen(void) {}
+
+#endif /* ENABLE_SCREEN_MIRROR */
+
+#endif /* SCREEN_MIRROR_H_ */
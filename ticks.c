@@ -0,0 +1,35 @@
+// Alien Advance
+// Michael Ebens
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "ticks.h"
+
+static volatile uint16_t ticks_overflow = 0;
+
+uint32_t ticks_now(void)
+{
+  uint8_t intr_state = SREG;
+  cli();
+  uint16_t low = TCNT1;
+  uint16_t high = ticks_overflow;
+
+  // TCNT1 wrapped after interrupts were masked, so the overflow
+  // hasn't been counted yet; a small low half means it was read after
+  if ((TIFR1 & (1 << TOV1)) && low < 0x8000) high++;
+
+  SREG = intr_state;
+  return ((uint32_t) high << 16) | low;
+}
+
+uint32_t ticks_to_ms(uint32_t ticks)
+{
+  // 128us per tick = 16ms per 125 ticks
+  return ticks / 125 * 16 + ticks % 125 * 16 / 125;
+}
+
+ISR(TIMER1_OVF_vect)
+{
+  ticks_overflow++;
+}
@@ -0,0 +1,36 @@
+// Alien Advance
+// Michael Ebens
+
+// Monotonic 32-bit system clock, counted in timer1 ticks. Timer1 runs
+// at 8MHz / 1024 = 7812.5Hz (128us per tick), with an overflow count
+// on top for the high 16 bits, so the clock wraps after about 6.4 days.
+//
+// Deadlines are compared through the signed difference, which stays
+// correct across the wrap as long as they are within 3.2 days of now.
+
+#ifndef TICKS_H_
+#define TICKS_H_
+
+#include <stdint.h>
+
+#define TICKS_PER_SEC 7812.5
+#define TICK_SECONDS (1 / TICKS_PER_SEC)
+#define TICKS_MS(ms) ((uint32_t) ((ms) * TICKS_PER_SEC / 1000))
+
+// ticks since startup, safe to call with interrupts on or off
+uint32_t ticks_now(void);
+
+// milliseconds in ticks, without overflowing for the whole clock range
+uint32_t ticks_to_ms(uint32_t ticks);
+
+static inline uint32_t ticks_since(uint32_t start, uint32_t now)
+{
+  return now - start;
+}
+
+static inline uint8_t ticks_reached(uint32_t deadline, uint32_t now)
+{
+  return (int32_t) (now - deadline) >= 0;
+}
+
+#endif /* TICKS_H_ */
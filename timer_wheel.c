@@ -0,0 +1,94 @@
+// Alien Advance
+// Michael Ebens
+
+#include "ticks.h"
+#include "timer_wheel.h"
+
+#define TIMER_NONE 0xFF
+
+uint8_t timer_state[NUM_TIMERS];
+
+static uint32_t timer_deadline[NUM_TIMERS];
+static uint8_t timer_next[NUM_TIMERS]; // next timer in the same slot
+static uint8_t timer_slot[NUM_TIMERS];
+static uint8_t slot_head[TIMER_WHEEL_SLOTS];
+
+// slot number the wheel has been advanced to, counting every slot
+// since startup (wrapping), so it can be compared with deadlines
+static uint16_t wheel_pos;
+
+static void unlink(uint8_t id)
+{
+  uint8_t* link = &slot_head[timer_slot[id]];
+  while (*link != id) link = &timer_next[*link];
+  *link = timer_next[id];
+}
+
+static void expire_slot(uint8_t slot, uint32_t now)
+{
+  uint8_t* link = &slot_head[slot];
+
+  while (*link != TIMER_NONE)
+  {
+    uint8_t id = *link;
+
+    // timers a lap or more ahead share the slot, and so do ones later
+    // in the current slot
+    if (ticks_reached(timer_deadline[id], now))
+    {
+      *link = timer_next[id];
+      timer_state[id] = TIMER_EXPIRED;
+    }
+    else
+    {
+      link = &timer_next[id];
+    }
+  }
+}
+
+void timer_wheel_init(uint32_t now)
+{
+  for (uint8_t i = 0; i < TIMER_WHEEL_SLOTS; i++) slot_head[i] = TIMER_NONE;
+  for (uint8_t i = 0; i < NUM_TIMERS; i++) timer_state[i] = TIMER_EXPIRED;
+  wheel_pos = now >> TIMER_WHEEL_SHIFT;
+}
+
+void timer_wheel_advance(uint32_t now)
+{
+  uint16_t target = now >> TIMER_WHEEL_SHIFT;
+
+  // after a long pause every slot is due, but only needs walking once
+  if ((uint16_t) (target - wheel_pos) >= TIMER_WHEEL_SLOTS) wheel_pos = target - (TIMER_WHEEL_SLOTS - 1);
+
+  // the slot the wheel is in is walked again on every call, as its
+  // timers only expire part way through
+  while (1)
+  {
+    expire_slot(wheel_pos & (TIMER_WHEEL_SLOTS - 1), now);
+    if (wheel_pos == target) break;
+    wheel_pos++;
+  }
+}
+
+void timer_set(uint8_t id, uint32_t deadline)
+{
+  if (timer_state[id] == TIMER_ARMED) unlink(id);
+
+  // a deadline behind the wheel goes in the current slot so it isn't
+  // left waiting a whole lap
+  uint16_t pos = deadline >> TIMER_WHEEL_SHIFT;
+  if ((int16_t) (pos - wheel_pos) < 0) pos = wheel_pos;
+
+  uint8_t slot = pos & (TIMER_WHEEL_SLOTS - 1);
+  timer_deadline[id] = deadline;
+  timer_slot[id] = slot;
+  timer_next[id] = slot_head[slot];
+  slot_head[slot] = id;
+  timer_state[id] = TIMER_ARMED;
+}
+
+void timer_cancel(uint8_t id)
+{
+  if (timer_state[id] == TIMER_ARMED) unlink(id);
+  timer_state[id] = TIMER_IDLE;
+}
@@ -0,0 +1,51 @@
+// Alien Advance
+// Michael Ebens
+
+// Timing wheel for the gameplay timers. Each timer is filed in the slot
+// its deadline falls in, and advancing the wheel only walks the slots
+// the clock has moved through since the last call, so the cost per
+// frame depends on how many timers expire rather than how many exist.
+//
+// Timers stay expired until they are set again or cancelled, which
+// makes timer_expired() a plain byte test for the game code.
+
+#ifndef TIMER_WHEEL_H_
+#define TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#include "config.h"
+
+// 1024 ticks (131ms) per slot, so the default 32 slots span 4.2s and
+// most deadlines come round on the first lap; later ones wait a lap
+#define TIMER_WHEEL_SHIFT 10
+
+#define TIMER_IDLE 0
+#define TIMER_ARMED 1
+#define TIMER_EXPIRED 2
+
+extern uint8_t timer_state[NUM_TIMERS];
+
+// all timers start out expired
+void timer_wheel_init(uint32_t now);
+
+// expire every armed timer whose deadline has been reached by now
+void timer_wheel_advance(uint32_t now);
+
+// arm (or re-arm) a timer, a deadline that has passed expires on the
+// next advance
+void timer_set(uint8_t id, uint32_t deadline);
+
+void timer_cancel(uint8_t id);
+
+static inline uint8_t timer_expired(uint8_t id)
+{
+  return timer_state[id] == TIMER_EXPIRED;
+}
+
+static inline uint8_t timer_armed(uint8_t id)
+{
+  return timer_state[id] == TIMER_ARMED;
+}
+
+#endif /* TIMER_WHEEL_H_ */
@@ -0,0 +1,115 @@
+// Alien Advance
+// Michael Ebens
+
+// Generates aim_table.h, the per-direction aim data kept in flash by
+// aim.c: the pixels of the aim line, where missiles are launched from
+// and how fast they move. Lines are traced the same way as draw_line()
+// in cab202_teensy/graphics.c, so the pattern matches what it drew.
+//
+// usage: aim_table > aim_table.h
+
+#include <math.h>
+#include <stdio.h>
+
+#define AIM_DIRECTIONS 64
+#define AIM_LINE_LENGTH 6  // pixels from the player's centre
+#define AIM_LAUNCH_OFFSET 2
+#define AIM_MISSILE_SPEED 10 // pixels per second
+#define MAX_PIXELS 16
+
+#define ABS(x) ((x) < 0 ? -(x) : (x))
+
+static int pixels[MAX_PIXELS][2];
+static int num_pixels;
+
+static void set_pixel(int x, int y)
+{
+  for (int i = 0; i < num_pixels; i++)
+  {
+    if (pixels[i][0] == x && pixels[i][1] == y) return;
+  }
+
+  pixels[num_pixels][0] = x;
+  pixels[num_pixels][1] = y;
+  num_pixels++;
+}
+
+// draw_line() from graphics.c, recording pixels instead of setting them
+static void trace_line(int x1, int y1, int x2, int y2)
+{
+  num_pixels = 0;
+
+  if (x1 == x2)
+  {
+    for (int i = y1; (y2 > y1) ? i <= y2 : i >= y2; (y2 > y1) ? i++ : i--) set_pixel(x1, i);
+  }
+  else if (y1 == y2)
+  {
+    for (int i = x1; (x2 > x1) ? i <= x2 : i >= x2; (x2 > x1) ? i++ : i--) set_pixel(i, y1);
+  }
+  else
+  {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float err = 0.0;
+    float derr = ABS(dy / dx);
+
+    for (int x = x1, y = y1; (dx > 0) ? x <= x2 : x >= x2; (dx > 0) ? x++ : x--)
+    {
+      set_pixel(x, y);
+      err += derr;
+
+      while (err >= 0.5 && ((dy > 0) ? y <= y2 : y >= y2))
+      {
+        set_pixel(x, y);
+        y += (dy > 0) - (dy < 0);
+        err -= 1.0;
+      }
+    }
+  }
+}
+
+int main(void)
+{
+  int max_pixels = 0;
+
+  for (int dir = 0; dir < AIM_DIRECTIONS; dir++)
+  {
+    double angle = dir * 2 * M_PI / AIM_DIRECTIONS;
+    trace_line(0, 0, lround(AIM_LINE_LENGTH * cos(angle)), lround(AIM_LINE_LENGTH * sin(angle)));
+    if (num_pixels > max_pixels) max_pixels = num_pixels;
+  }
+
+  printf("// Alien Advance\n");
+  printf("// Michael Ebens\n\n");
+  printf("// Generated by tools/aim_table.c (make aim_table.h), do not edit.\n");
+  printf("// Directions go clockwise on screen from pointing right.\n\n");
+  printf("#ifndef AIM_TABLE_H_\n#define AIM_TABLE_H_\n\n");
+  printf("#define AIM_DIRECTIONS %d\n", AIM_DIRECTIONS);
+  printf("#define AIM_LINE_PIXELS %d\n\n", max_pixels);
+  printf("// { line pixels, pixel count, launch x, y (8.8), speed x, y (8.8 per second) }\n");
+  printf("#define AIM_TABLE { \\\n");
+
+  for (int dir = 0; dir < AIM_DIRECTIONS; dir++)
+  {
+    double angle = dir * 2 * M_PI / AIM_DIRECTIONS;
+    trace_line(0, 0, lround(AIM_LINE_LENGTH * cos(angle)), lround(AIM_LINE_LENGTH * sin(angle)));
+
+    printf("  { {");
+
+    for (int i = 0; i < max_pixels; i++)
+    {
+      int x = i < num_pixels ? pixels[i][0] : 0;
+      int y = i < num_pixels ? pixels[i][1] : 0;
+      printf(" { %d, %d }%s", x, y, i + 1 < max_pixels ? "," : "");
+    }
+
+    printf(" }, %d, %ld, %ld, %ld, %ld }%s \\\n", num_pixels,
+      lround(AIM_LAUNCH_OFFSET * cos(angle) * 256), lround(AIM_LAUNCH_OFFSET * sin(angle) * 256),
+      lround(AIM_MISSILE_SPEED * cos(angle) * 256), lround(AIM_MISSILE_SPEED * sin(angle) * 256),
+      dir + 1 < AIM_DIRECTIONS ? "," : "");
+  }
+
+  printf("}\n\n#endif /* AIM_TABLE_H_ */\n");
+  return 0;
+}
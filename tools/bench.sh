@@ -0,0 +1,34 @@
+#!/bin/sh
+# Alien Advance
+# Michael Ebens
+
+# Runs the bench build of the game (bench.h) under simavr and fails
+# unless it finishes with every profiled span inside its cycle budget.
+#
+# usage: bench.sh bench.elf
+#
+# SIMAVR names the simulator (default simavr, run_avr in a source build).
+
+elf=$1
+SIMAVR=${SIMAVR:-simavr}
+
+# the firmware sleeps with interrupts off when done, which ends the run;
+# the timeout catches one that never gets there
+out=$(timeout 300 "$SIMAVR" "$elf" 2>&1)
+status=$?
+
+echo "$out" | sed -n 's/^.*BENCH \([^ ]* [0-9]* [0-9]*.*\)$/\1/p' | awk '
+  BEGIN { printf "%-14s %8s %8s\n", "span", "cycles", "budget" }
+  { printf "%-14s %8d %8d %s\n", $1, $2, $3, $4 }'
+
+if [ $status -eq 124 ]
+then
+  echo "bench timed out"
+  exit 1
+fi
+
+if ! echo "$out" | grep -q "BENCH PASS"
+then
+  echo "$out" | grep -q "BENCH FAIL" && echo "over cycle budget" || { echo "bench did not finish:"; echo "$out"; }
+  exit 1
+fi
@@ -0,0 +1,297 @@
+// Alien Advance
+// Michael Ebens
+
+// Host check of collide.c against brute force references:
+//
+//   sweep_hits       exact time intervals per axis, as fractions
+//   sprites_overlap  every pixel of the overlap tested on its own
+//   sweep_overlaps   must hit wherever a finely sampled path hits, and
+//                    may only hit at positions the path's closed
+//                    pixel squares touch (the walk picks one side when
+//                    the path goes exactly through a corner)
+//
+// usage: check_collide [cases]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../collide.h"
+
+// num / den with den > 0
+typedef struct fraction {
+  long long num, den;
+} Fraction;
+
+static int less(Fraction a, Fraction b)
+{
+  return a.num * b.den < b.num * a.den;
+}
+
+// the open interval of times when lo < p + d * t < hi
+static int axis_times(int p, int d, int lo, int hi, Fraction* enter, Fraction* leave)
+{
+  if (!d)
+  {
+    // the whole frame or never
+    enter->num = -1;
+    enter->den = 1;
+    leave->num = 2;
+    leave->den = 1;
+    return lo < p && p < hi;
+  }
+
+  Fraction a = { lo - p, d };
+  Fraction b = { hi - p, d };
+
+  if (d < 0)
+  {
+    a.num = -a.num;
+    a.den = -d;
+    b.num = -b.num;
+    b.den = -d;
+  }
+
+  *enter = less(a, b) ? a : b;
+  *leave = less(a, b) ? b : a;
+  return 1;
+}
+
+static int reference_hits(const Sweep* s, int x, int y, int width, int height)
+{
+  Fraction enter_x, leave_x, enter_y, leave_y;
+
+  if (!axis_times(s->x, s->dx, x - s->width * 256, x + width * 256, &enter_x, &leave_x)) return 0;
+  if (!axis_times(s->y, s->dy, y - s->height * 256, y + height * 256, &enter_y, &leave_y)) return 0;
+
+  Fraction enter = less(enter_x, enter_y) ? enter_y : enter_x;
+  Fraction leave = less(leave_x, leave_y) ? leave_x : leave_y;
+  Fraction zero = { 0, 1 };
+  Fraction one = { 1, 1 };
+
+  // some time in [0, 1] inside both open intervals
+  return less(enter, leave) && less(enter, one) && less(zero, leave);
+}
+
+static unsigned long check_sweep_hits(long cases)
+{
+  unsigned long mismatches = 0;
+  unsigned long hits = 0;
+
+  for (long n = 0; n < cases; n++)
+  {
+    Sweep s;
+    int fast = rand() % 3 == 0;
+
+    s.x = rand() % (84 * 256);
+    s.y = rand() % (48 * 256);
+    s.dx = fast ? rand() % 20001 - 10000 : rand() % 2001 - 1000;
+    s.dy = fast ? rand() % 20001 - 10000 : rand() % 2001 - 1000;
+    if (rand() % 5 == 0) s.dx = 0;
+    if (rand() % 5 == 0) s.dy = 0;
+    s.width = 1 + rand() % 4;
+    s.height = 1 + rand() % 4;
+    s.bitmap = NULL;
+
+    // whole pixel targets like FIX8(enemy.x), plus the odd fraction
+    int x = (rand() % 84) * 256 + (rand() % 4 == 0 ? rand() % 256 : 0);
+    int y = (rand() % 48) * 256 + (rand() % 4 == 0 ? rand() % 256 : 0);
+    int size = 1 + rand() % 16;
+
+    int expected = reference_hits(&s, x, y, size, size);
+    hits += expected;
+    if (sweep_hits(&s, x, y, size, size) != expected) mismatches++;
+  }
+
+  printf("sweep_hits: %ld cases, %lu hits, %lu mismatches\n", cases, hits, mismatches);
+  return mismatches;
+}
+
+static unsigned char bitmaps[2][32];
+
+static void random_bitmap(unsigned char* bitmap)
+{
+  // sparse, so misses through the gaps are common
+  for (int i = 0; i < 32; i++) bitmap[i] = rand() & rand();
+}
+
+static int pixel(const unsigned char* bitmap, int width, int height, int x, int y)
+{
+  if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+  return (bitmap[y * ((width + 7) / 8) + x / 8] >> (7 - x % 8)) & 1;
+}
+
+static int reference_overlap(const unsigned char* a, int a_width, int a_height, int ax, int ay,
+                             const unsigned char* b, int b_width, int b_height, int bx, int by)
+{
+  for (int y = ay; y < ay + a_height; y++)
+  {
+    for (int x = ax; x < ax + a_width; x++)
+    {
+      if (pixel(a, a_width, a_height, x - ax, y - ay) && pixel(b, b_width, b_height, x - bx, y - by)) return 1;
+    }
+  }
+
+  return 0;
+}
+
+static void random_sprite(Sprite* sprite, unsigned char* bitmap)
+{
+  random_bitmap(bitmap);
+  sprite->bitmap = bitmap;
+  sprite->width = 1 + rand() % 16;
+  sprite->height = 1 + rand() % 16;
+  sprite->x = 20 + rand() % 40 + (rand() % 100) / 100.0;
+  sprite->y = 10 + rand() % 20 + (rand() % 100) / 100.0;
+}
+
+static unsigned long check_sprites_overlap(long cases)
+{
+  unsigned long mismatches = 0;
+  unsigned long hits = 0;
+
+  for (long n = 0; n < cases; n++)
+  {
+    Sprite a, b;
+    random_sprite(&a, bitmaps[0]);
+    random_sprite(&b, bitmaps[1]);
+    b.x = a.x + rand() % 37 - 18;
+    b.y = a.y + rand() % 37 - 18;
+
+    // truncated the same way as draw_sprite()
+    int expected = reference_overlap(a.bitmap, a.width, a.height, (unsigned char) a.x, (unsigned char) a.y,
+                                     b.bitmap, b.width, b.height, (unsigned char) b.x, (unsigned char) b.y);
+    hits += expected;
+    if (sprites_overlap(&a, &b) != expected) mismatches++;
+  }
+
+  printf("sprites_overlap: %ld cases, %lu hits, %lu mismatches\n", cases, hits, mismatches);
+  return mismatches;
+}
+
+// floor division, for 8.8 positions left of zero
+static int floor_div(long long num, long long den)
+{
+  return num >= 0 ? num / den : -((-num + den - 1) / den);
+}
+
+// the closed pixel square at (px, py) meets the path
+static int path_touches(const Sweep* s, int px, int py)
+{
+  Fraction enter = { 0, 1 };
+  Fraction leave = { 1, 1 };
+  int p[2] = { s->x, s->y };
+  int d[2] = { s->dx, s->dy };
+  int lo[2] = { px * 256, py * 256 };
+
+  for (int axis = 0; axis < 2; axis++)
+  {
+    if (!d[axis])
+    {
+      if (p[axis] < lo[axis] || p[axis] > lo[axis] + 256) return 0;
+      continue;
+    }
+
+    Fraction a = { lo[axis] - p[axis], d[axis] };
+    Fraction b = { lo[axis] + 256 - p[axis], d[axis] };
+
+    if (d[axis] < 0)
+    {
+      a.num = -a.num;
+      a.den = -a.den;
+      b.num = -b.num;
+      b.den = -b.den;
+    }
+
+    if (less(b, a))
+    {
+      Fraction swap = a;
+      a = b;
+      b = swap;
+    }
+
+    if (less(enter, a)) enter = a;
+    if (less(b, leave)) leave = b;
+  }
+
+  return !less(leave, enter);
+}
+
+static unsigned long check_sweep_overlaps(long cases)
+{
+  const int samples = 1024;
+  unsigned long misses = 0;
+  unsigned long false_hits = 0;
+  unsigned long hits = 0;
+
+  for (long n = 0; n < cases; n++)
+  {
+    Sweep s;
+    Sprite target;
+
+    random_bitmap(bitmaps[0]);
+    s.bitmap = bitmaps[0];
+    s.width = 1 + rand() % 4;
+    s.height = 1 + rand() % 4;
+    s.x = (10 + rand() % 60) * 256 + rand() % 256;
+    s.y = (10 + rand() % 30) * 256 + rand() % 256;
+    s.dx = rand() % 3001 - 1500;
+    s.dy = rand() % 3001 - 1500;
+    if (rand() % 5 == 0) s.dx = 0;
+    if (rand() % 5 == 0) s.dy = 0;
+
+    random_sprite(&target, bitmaps[1]);
+    target.x = (s.x >> 8) + rand() % 17 - 8;
+    target.y = (s.y >> 8) + rand() % 17 - 8;
+    int tx = (unsigned char) target.x;
+    int ty = (unsigned char) target.y;
+
+    int hit = sweep_overlaps(&s, &target);
+    hits += hit;
+
+    // lower bound, positions along the path
+    int sampled = 0;
+
+    for (int k = 0; k <= samples && !sampled; k++)
+    {
+      int x = floor_div((long long) s.x * samples + (long long) s.dx * k, 256 * samples);
+      int y = floor_div((long long) s.y * samples + (long long) s.dy * k, 256 * samples);
+      sampled = reference_overlap(s.bitmap, s.width, s.height, x, y, target.bitmap, target.width, target.height, tx, ty);
+    }
+
+    if (sampled && !hit) misses++;
+    if (!hit || sampled) continue;
+
+    // upper bound, every pixel square the path touches
+    int touched = 0;
+    int x0 = floor_div(s.x < s.x + s.dx ? s.x : s.x + s.dx, 256) - 1;
+    int x1 = floor_div(s.x > s.x + s.dx ? s.x : s.x + s.dx, 256) + 1;
+    int y0 = floor_div(s.y < s.y + s.dy ? s.y : s.y + s.dy, 256) - 1;
+    int y1 = floor_div(s.y > s.y + s.dy ? s.y : s.y + s.dy, 256) + 1;
+
+    for (int y = y0; y <= y1 && !touched; y++)
+    {
+      for (int x = x0; x <= x1 && !touched; x++)
+      {
+        touched = path_touches(&s, x, y)
+          && reference_overlap(s.bitmap, s.width, s.height, x, y, target.bitmap, target.width, target.height, tx, ty);
+      }
+    }
+
+    if (!touched) false_hits++;
+  }
+
+  printf("sweep_overlaps: %ld cases, %lu hits, %lu misses, %lu false hits\n", cases, hits, misses, false_hits);
+  return misses + false_hits;
+}
+
+int main(int argc, char** argv)
+{
+  long cases = argc > 1 ? atol(argv[1]) : 1000000;
+
+  srand(1);
+
+  unsigned long mismatches = check_sweep_hits(cases);
+  mismatches += check_sprites_overlap(cases);
+  mismatches += check_sweep_overlaps(cases / 10);
+  return mismatches != 0;
+}
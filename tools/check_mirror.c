@@ -0,0 +1,281 @@
+// Alien Advance
+// Michael Ebens
+
+// Host check of screen_mirror.c: the encoder runs against a model of
+// the transmit ring and its stream is decoded the way mirror_decode
+// does it. Screens change at random between frames, the host drains
+// the ring at random rates (sometimes not at all), and debug lines are
+// queued alongside. Checked:
+//
+//   - the decoded copy matches the frame shown whenever a frame op has
+//     MIRROR_FRAME_EXACT set
+//   - an exact frame op's skipped count is the number of frames shown
+//     since the last one the host held exactly (up to
+//     MIRROR_MAX_SKIPPED)
+//   - the encoder leaves MIRROR_TEXT_HEADROOM bytes of the ring free
+//   - the debug text comes through unchanged between the packets
+//
+// usage: check_mirror [frames]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../screen_mirror.h"
+#include "../usb_serial.h"
+
+#include <graphics.h>
+
+#if !ENABLE_SCREEN_MIRROR
+#error "build check_mirror with ENABLE_SCREEN_MIRROR=1"
+#endif
+
+unsigned char screen_buffer[LCD_BUFFER_SIZE];
+
+// the transmit ring, only its fill level matters
+static unsigned int ring_used = 0;
+
+// everything written to the ring this frame, consumed by the decoder
+static unsigned char stream[4096];
+static unsigned int stream_length = 0;
+
+// debug text queued and decoded this frame
+static unsigned char text_sent[TX_RING_SIZE];
+static unsigned int text_sent_length = 0;
+static unsigned char text_got[TX_RING_SIZE];
+static unsigned int text_got_length = 0;
+
+static unsigned long failures = 0;
+
+uint8_t usb_configured(void)
+{
+  return 1;
+}
+
+uint8_t usb_serial_tx_free(void)
+{
+  return TX_RING_SIZE - ring_used;
+}
+
+uint16_t usb_serial_tx_write(const uint8_t* buffer, uint16_t size)
+{
+  if (size > TX_RING_SIZE - ring_used)
+  {
+    printf("write of %u bytes with %u free\n", size, TX_RING_SIZE - ring_used);
+    exit(1);
+  }
+
+  memcpy(stream + stream_length, buffer, size);
+  stream_length += size;
+  ring_used += size;
+  return size;
+}
+
+// host side
+static unsigned char host[LCD_BUFFER_SIZE];
+static int host_exact = 0;   // the last frame op was exact
+static int host_mid_pass = 1; // packets arrived since the last frame op
+
+// returns the frame op in the stream consumed, or -1
+static int decode(void)
+{
+  unsigned int p = 0;
+  int frame_op = -1;
+
+  while (p < stream_length)
+  {
+    if (stream[p] != MIRROR_MAGIC0)
+    {
+      text_got[text_got_length++] = stream[p++];
+      continue;
+    }
+
+    // packets are always written whole
+    unsigned int length = stream[p + 2] | (stream[p + 3] << 8);
+    const unsigned char* data = stream + p + 4;
+    unsigned int i = data[0] | (data[1] << 8);
+    unsigned int q = 2;
+
+    if (stream[p + 1] != MIRROR_MAGIC1 || p + 4 + length > stream_length)
+    {
+      printf("bad packet header\n");
+      exit(1);
+    }
+
+    host_mid_pass = 1;
+
+    while (q < length)
+    {
+      unsigned char op = data[q++];
+      unsigned int n = (op & ~MIRROR_OP_TYPE) + 1;
+
+      switch (op & MIRROR_OP_TYPE)
+      {
+        case MIRROR_OP_SKIP:
+          i += n;
+          break;
+
+        case MIRROR_OP_RUN:
+          memset(&host[i], data[q++], n);
+          i += n;
+          break;
+
+        case MIRROR_OP_LITERAL:
+          memcpy(&host[i], &data[q], n);
+          q += n;
+          i += n;
+          break;
+
+        case MIRROR_OP_FRAME:
+          frame_op = op;
+          host_exact = (op & MIRROR_FRAME_EXACT) != 0;
+          host_mid_pass = 0;
+          i = 0;
+          break;
+      }
+
+      if (i > LCD_BUFFER_SIZE)
+      {
+        printf("packet runs past the screen\n");
+        exit(1);
+      }
+    }
+
+    p += 4 + length;
+  }
+
+  stream_length = 0;
+  return frame_op;
+}
+
+static void change_screen(void)
+{
+  int kind = rand() % 10;
+
+  if (kind < 2)
+  {
+    // unchanged
+  }
+  else if (kind < 6)
+  {
+    // a few sprite sized changes
+    for (int k = rand() % 4; k >= 0; k--)
+    {
+      int at = rand() % (LCD_BUFFER_SIZE - 16);
+      for (int i = rand() % 16; i >= 0; i--) screen_buffer[at + i] ^= rand();
+    }
+  }
+  else if (kind < 8)
+  {
+    // scattered bytes, repeats and runs
+    for (int k = rand() % 200; k >= 0; k--)
+    {
+      int at = rand() % LCD_BUFFER_SIZE;
+      screen_buffer[at] = rand() % 3 ? rand() : screen_buffer[at ? at - 1 : 0];
+    }
+  }
+  else if (kind < 9)
+  {
+    memset(screen_buffer, rand() % 2 ? 0 : rand(), LCD_BUFFER_SIZE);
+  }
+  else
+  {
+    for (int i = 0; i < LCD_BUFFER_SIZE; i++) screen_buffer[i] = rand();
+  }
+}
+
+static void queue_text(void)
+{
+  // a debug line, only when all of it fits (as send_debug_string does)
+  unsigned int length = 20 + rand() % 60;
+  if (length > TX_RING_SIZE - ring_used) return;
+
+  unsigned char line[128];
+  for (unsigned int i = 0; i < length; i++) line[i] = ' ' + rand() % 95;
+  memcpy(text_sent + text_sent_length, line, length);
+  text_sent_length += length;
+  usb_serial_tx_write(line, length);
+}
+
+int main(int argc, char** argv)
+{
+  long frames = argc > 1 ? atol(argv[1]) : 200000;
+  unsigned long exact = 0, torn = 0, skipped = 0, unsent = 0;
+  unsigned int not_held = 0; // frames shown since the host last held one exactly
+
+  srand(1);
+  mirror_start();
+
+  for (long frame = 0; frame < frames; frame++)
+  {
+    // the host drains the ring, or stalls for a while
+    int drain = rand() % 8;
+    if (drain < 5) ring_used = 0;
+    else if (drain < 7) ring_used -= ring_used ? rand() % (ring_used + 1) : 0;
+
+    if (rand() % 1000 == 0)
+    {
+      mirror_stop();
+      mirror_start();
+      not_held = 0;
+    }
+
+    change_screen();
+    if (rand() % 3 == 0) queue_text();
+
+    unsigned int free_before = TX_RING_SIZE - ring_used;
+    mirror_screen();
+    unsigned int sent = free_before - (TX_RING_SIZE - ring_used);
+
+    if (sent && free_before - sent < MIRROR_TEXT_HEADROOM)
+    {
+      if (!failures++) printf("frame %ld: left %u bytes free\n", frame, free_before - sent);
+    }
+
+    int frame_op = decode();
+
+    if (text_got_length != text_sent_length || memcmp(text_got, text_sent, text_sent_length))
+    {
+      if (!failures++) printf("frame %ld: debug text changed on the way\n", frame);
+    }
+
+    text_sent_length = 0;
+    text_got_length = 0;
+
+    if (frame_op != -1 && (frame_op & MIRROR_FRAME_EXACT))
+    {
+      exact++;
+      unsigned int expected = not_held < MIRROR_MAX_SKIPPED ? not_held : MIRROR_MAX_SKIPPED;
+
+      if (memcmp(host, screen_buffer, LCD_BUFFER_SIZE))
+      {
+        if (!failures++) printf("frame %ld: exact frame doesn't match the screen\n", frame);
+      }
+      else if ((unsigned int) (frame_op & MIRROR_MAX_SKIPPED) != expected)
+      {
+        if (!failures++) printf("frame %ld: %u skipped, expected %u\n", frame, frame_op & MIRROR_MAX_SKIPPED, expected);
+      }
+
+      skipped += frame_op & MIRROR_MAX_SKIPPED;
+      not_held = 0;
+    }
+    else if (frame_op != -1)
+    {
+      torn++;
+      not_held++;
+    }
+    else if (!host_mid_pass && host_exact && !memcmp(host, screen_buffer, LCD_BUFFER_SIZE))
+    {
+      // unchanged since the last exact frame, nothing needs sending
+      unsent++;
+    }
+    else
+    {
+      not_held++;
+    }
+  }
+
+  printf("mirror: %ld frames, %lu exact, %lu torn, %lu skipped, %lu unchanged, %lu failures\n",
+    frames, exact, torn, skipped, unsent, failures);
+  return failures != 0;
+}
@@ -0,0 +1,117 @@
+// Alien Advance
+// Michael Ebens
+
+// Host check of the byte-wise rectangles in cab202_teensy/graphics.c
+// (fill_rect, clear_rect, invert_rect) against the same rectangle
+// drawn with set_pixel, one pixel at a time with unsigned char
+// coordinates, over random screens. Positions and sizes are picked on
+// screen, just off the right and bottom edges, "negative" (wrapped
+// past 255) and anywhere at all.
+//
+// usage: check_rect [cases]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <graphics.h>
+
+// graphics.c's show_screen() links against these
+void lcd_position(unsigned char x, unsigned char y) {}
+void lcd_write(unsigned char dc, unsigned char data) {}
+
+static unsigned char coordinate(void)
+{
+  switch (rand() % 4)
+  {
+    case 0:
+      return rand() % LCD_X;
+
+    case 1:
+      return LCD_Y - 4 + rand() % (LCD_X - LCD_Y + 8);
+
+    case 2:
+      return 256 - 1 - rand() % 16;
+
+    default:
+      return rand();
+  }
+}
+
+static unsigned char size(void)
+{
+  switch (rand() % 4)
+  {
+    case 0:
+      return rand() % 10;
+
+    case 1:
+      return rand() % (LCD_X + 1);
+
+    case 2:
+      return 256 - rand() % 8;
+
+    default:
+      return rand();
+  }
+}
+
+static int pixel(unsigned char x, unsigned char y)
+{
+  return (screen_buffer[(y / 8) * LCD_X + x] >> (y % 8)) & 1;
+}
+
+static void reference(unsigned char x, unsigned char y, unsigned char width, unsigned char height, int op)
+{
+  for (int i = 0; i < width; i++)
+  {
+    for (int j = 0; j < height; j++)
+    {
+      unsigned char px = x + i;
+      unsigned char py = y + j;
+      if (px >= LCD_X || py >= LCD_Y) continue;
+
+      set_pixel(px, py, op == 0 ? 1 : op == 1 ? 0 : !pixel(px, py));
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  long cases = argc > 1 ? atol(argv[1]) : 100000;
+  static const char* names[] = { "fill_rect", "clear_rect", "invert_rect" };
+  unsigned char before[LCD_BUFFER_SIZE];
+  unsigned char fast[LCD_BUFFER_SIZE];
+  unsigned long mismatches = 0;
+
+  srand(1);
+
+  for (long n = 0; n < cases; n++)
+  {
+    for (int i = 0; i < LCD_BUFFER_SIZE; i++) before[i] = rand();
+
+    unsigned char x = coordinate();
+    unsigned char y = coordinate();
+    unsigned char width = size();
+    unsigned char height = size();
+    int op = rand() % 3;
+
+    memcpy(screen_buffer, before, LCD_BUFFER_SIZE);
+    if (op == 0) fill_rect(x, y, width, height);
+    else if (op == 1) clear_rect(x, y, width, height);
+    else invert_rect(x, y, width, height);
+    memcpy(fast, screen_buffer, LCD_BUFFER_SIZE);
+
+    memcpy(screen_buffer, before, LCD_BUFFER_SIZE);
+    reference(x, y, width, height, op);
+
+    if (memcmp(fast, screen_buffer, LCD_BUFFER_SIZE))
+    {
+      if (!mismatches) printf("%s(%u, %u, %u, %u) differs from set_pixel\n", names[op], x, y, width, height);
+      mismatches++;
+    }
+  }
+
+  printf("rect: %ld cases, %lu mismatches\n", cases, mismatches);
+  return mismatches != 0;
+}
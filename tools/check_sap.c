@@ -0,0 +1,124 @@
+// Alien Advance
+// Michael Ebens
+
+// Host check and benchmark of sap.c. Bodies drift across the screen a
+// little each frame like missiles and enemies do, dropping out and
+// coming back at random. Every frame the pairs sap_sweep() reports are
+// compared against testing every missile against every enemy, and both
+// are timed.
+//
+// usage: check_sap [frames]
+//
+// SAP_BODIES is fixed at compile time, so make bench-sap builds this
+// once per body count to show how the two scale.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../sap.h"
+
+static int16_t left[SAP_BODIES];
+static int16_t right[SAP_BODIES];
+static uint8_t present[SAP_BODIES];
+static uint8_t found[SAP_BODIES][SAP_BODIES];
+static unsigned long sap_pairs = 0;
+
+static void record_pair(uint8_t a, uint8_t b)
+{
+  found[a][b]++;
+  sap_pairs++;
+}
+
+static void brute_force(uint8_t split, void (*overlap)(uint8_t a, uint8_t b))
+{
+  for (uint8_t a = 0; a < split; a++)
+  {
+    if (!present[a]) continue;
+
+    for (uint8_t b = split; b < SAP_BODIES; b++)
+    {
+      if (present[b] && right[a] > left[b] && right[b] > left[a]) overlap(a, b);
+    }
+  }
+}
+
+static void count_pair(uint8_t a, uint8_t b)
+{
+  sap_pairs++;
+}
+
+static double seconds(clock_t start)
+{
+  return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char** argv)
+{
+  long frames = argc > 1 ? atol(argv[1]) : 200000;
+  unsigned long mismatches = 0;
+  unsigned long pairs = 0;
+
+  srand(1);
+
+  // whole screen in 8.8, enemies 5 pixels wide and missiles 2
+  for (int i = 0; i < SAP_BODIES; i++)
+  {
+    left[i] = rand() % (82 * 256);
+    right[i] = left[i] + (i < NUM_MISSILES ? 2 : 5) * 256;
+    present[i] = 1;
+  }
+
+  double sap_time = 0;
+  double brute_time = 0;
+
+  for (long frame = 0; frame < frames; frame++)
+  {
+    for (int i = 0; i < SAP_BODIES; i++)
+    {
+      if (rand() % 20 == 0) present[i] = !present[i];
+
+      int width = right[i] - left[i];
+      int x = left[i] + rand() % 601 - 300;
+      if (x < 0) x = 0;
+      if (x > 82 * 256) x = 82 * 256;
+      left[i] = x;
+      right[i] = x + width;
+    }
+
+    memset(found, 0, sizeof(found));
+
+    clock_t start = clock();
+
+    for (int i = 0; i < SAP_BODIES; i++)
+    {
+      if (present[i]) sap_set(i, left[i], right[i]);
+      else sap_remove(i);
+    }
+
+    sap_sort();
+    sap_sweep(NUM_MISSILES, record_pair);
+    sap_time += seconds(start);
+
+    start = clock();
+    brute_force(NUM_MISSILES, count_pair);
+    brute_time += seconds(start);
+
+    // every expected pair reported exactly once, and nothing else
+    for (int a = 0; a < SAP_BODIES; a++)
+    {
+      for (int b = 0; b < SAP_BODIES; b++)
+      {
+        int expected = a < NUM_MISSILES && b >= NUM_MISSILES && present[a] && present[b]
+          && right[a] > left[b] && right[b] > left[a];
+        pairs += expected;
+        if (found[a][b] != expected) mismatches++;
+      }
+    }
+  }
+
+  printf("sap: %d bodies, %ld frames, %lu pairs, %lu mismatches, %.0fns sweep and prune, %.0fns brute force per frame\n",
+    SAP_BODIES, frames, pairs, mismatches, sap_time * 1e9 / frames, brute_time * 1e9 / frames);
+  return mismatches != 0;
+}
@@ -0,0 +1,66 @@
+// Alien Advance
+// Michael Ebens
+
+// Host check of timer_wheel.c against a model that tests every timer's
+// deadline directly on each advance. The clock starts just short of
+// wrapping, steps by up to a few frames at a time with the odd jump of
+// several laps, and timers are set, re-set and cancelled at random.
+//
+// usage: check_timer_wheel [steps]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../timer_wheel.h"
+
+int main(int argc, char** argv)
+{
+  long steps = argc > 1 ? atol(argv[1]) : 2000000;
+
+  uint32_t now = 0xFFF00000;
+  uint32_t deadline[NUM_TIMERS];
+  uint8_t state[NUM_TIMERS];
+  unsigned long mismatches = 0;
+  unsigned long expired = 0;
+
+  timer_wheel_init(now);
+  for (int i = 0; i < NUM_TIMERS; i++) state[i] = TIMER_EXPIRED;
+
+  srand(1);
+
+  for (long step = 0; step < steps; step++)
+  {
+    now += (rand() % 100 < 2) ? rand() % 200000 : rand() % 120;
+    timer_wheel_advance(now);
+
+    for (int i = 0; i < NUM_TIMERS; i++)
+    {
+      if (state[i] == TIMER_ARMED && (int32_t) (now - deadline[i]) >= 0)
+      {
+        state[i] = TIMER_EXPIRED;
+        expired++;
+      }
+
+      if (state[i] != timer_state[i]) mismatches++;
+    }
+
+    // deadlines up to a few laps ahead, and a few already passed
+    int id = rand() % NUM_TIMERS;
+    int op = rand() % 10;
+
+    if (op < 3)
+    {
+      deadline[id] = now + rand() % 70000 - 2000;
+      state[id] = TIMER_ARMED;
+      timer_set(id, deadline[id]);
+    }
+    else if (op == 3)
+    {
+      state[id] = TIMER_IDLE;
+      timer_cancel(id);
+    }
+  }
+
+  printf("timer_wheel: %ld steps, %lu expiries, %lu mismatches\n", steps, expired, mismatches);
+  return mismatches != 0;
+}
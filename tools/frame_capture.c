@@ -0,0 +1,186 @@
+// Alien Advance
+// Michael Ebens
+
+// Converts raw screen_buffer frames (LCD_BUFFER_SIZE bytes each, as
+// recorded by mirror_decode -r) into PBM images, and prints a hash of
+// every frame so captures can be diffed quickly.
+//
+// Captures only hold the frames that reached the host intact (see
+// MIRROR_FRAME_EXACT in screen_mirror.h), and the game runs on real
+// time and real input, so two captures of a session won't line up
+// frame for frame.
+//
+// usage: frame_capture [-o prefix] [-s stream.pbm] [frames.raw]
+//   -o  write each frame to prefix000000.pbm, prefix000001.pbm, ...
+//   -s  write all frames to one multi-image PBM stream (an animation
+//       that netpbm tools and most viewers can step through)
+//
+// Reads stdin when no file is given, e.g.
+//   mirror_decode -q -r /dev/stdout /dev/ttyACM0 | frame_capture -o cap/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LCD_X 84
+#define LCD_Y 48
+#define LCD_BUFFER_SIZE (LCD_X * (LCD_Y / 8))
+
+// PBM rows are packed MSB first, padded to whole bytes
+#define PBM_ROW_BYTES ((LCD_X + 7) / 8)
+#define PBM_HEADER "P4\n84 48\n"
+
+// FNV-1a, enough to tell frames apart
+static uint32_t hash_frame(const unsigned char* frame)
+{
+  uint32_t hash = 2166136261u;
+
+  for (int i = 0; i < LCD_BUFFER_SIZE; i++)
+  {
+    hash = (hash ^ frame[i]) * 16777619u;
+  }
+
+  return hash;
+}
+
+// Transposes an 8x8 bit block. On input byte c (bits 8c..8c+7) is the
+// column c from the LCD bank, bit r being row r. On output byte r is
+// pixel row r with column c in bit 7 - c, as PBM wants it.
+static uint64_t transpose_block(uint64_t x)
+{
+  uint64_t t;
+
+  // standard three stage swap (Hacker's Delight 7-3), giving byte r
+  // bit c = input byte c bit r
+  t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+  x = x ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+  x = x ^ t ^ (t << 14);
+  t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+  x = x ^ t ^ (t << 28);
+
+  // mirror the bits of every byte, so column 0 is the MSB
+  x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+  x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+  x = ((x >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((x & 0x0F0F0F0F0F0F0F0Full) << 4);
+  return x;
+}
+
+// PCD8544 bank layout (one byte = 8 vertical pixels) to PBM rows
+static void frame_to_pbm(const unsigned char* frame, unsigned char* pbm)
+{
+  for (int bank = 0; bank < LCD_Y / 8; bank++)
+  {
+    const unsigned char* columns = frame + bank * LCD_X;
+    unsigned char* rows = pbm + bank * 8 * PBM_ROW_BYTES;
+
+    for (int group = 0; group < PBM_ROW_BYTES; group++)
+    {
+      uint64_t block = 0;
+      int width = LCD_X - group * 8;
+      if (width > 8) width = 8;
+
+      for (int c = 0; c < width; c++)
+      {
+        block |= (uint64_t) columns[group * 8 + c] << (8 * c);
+      }
+
+      block = transpose_block(block);
+
+      for (int r = 0; r < 8; r++)
+      {
+        rows[r * PBM_ROW_BYTES + group] = block >> (8 * r);
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const char* prefix = NULL;
+  const char* stream_path = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "o:s:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'o':
+        prefix = optarg;
+        break;
+
+      case 's':
+        stream_path = optarg;
+        break;
+
+      default:
+        fprintf(stderr, "usage: %s [-o prefix] [-s stream.pbm] [frames.raw]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  FILE* in = stdin;
+
+  if (optind < argc && !(in = fopen(argv[optind], "rb")))
+  {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  FILE* stream = NULL;
+
+  if (stream_path && !(stream = fopen(stream_path, "wb")))
+  {
+    perror(stream_path);
+    return 1;
+  }
+
+  unsigned char frame[LCD_BUFFER_SIZE];
+  unsigned char pbm[sizeof(PBM_HEADER) - 1 + LCD_Y * PBM_ROW_BYTES];
+  unsigned char* pixels = pbm + sizeof(PBM_HEADER) - 1;
+  memcpy(pbm, PBM_HEADER, sizeof(PBM_HEADER) - 1);
+
+  unsigned long frames = 0;
+  clock_t start = clock();
+
+  while (fread(frame, 1, LCD_BUFFER_SIZE, in) == LCD_BUFFER_SIZE)
+  {
+    printf("%06lu %08x\n", frames, hash_frame(frame));
+
+    if (prefix || stream)
+    {
+      frame_to_pbm(frame, pixels);
+
+      if (stream) fwrite(pbm, 1, sizeof(pbm), stream);
+
+      if (prefix)
+      {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s%06lu.pbm", prefix, frames);
+        FILE* out = fopen(path, "wb");
+
+        if (!out)
+        {
+          perror(path);
+          return 1;
+        }
+
+        fwrite(pbm, 1, sizeof(pbm), out);
+        fclose(out);
+      }
+    }
+
+    frames++;
+  }
+
+  double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+  fprintf(stderr, "%lu frames in %.3fs", frames, seconds);
+  if (seconds > 0) fprintf(stderr, " (%.0f frames/s)", frames / seconds);
+  fputc('\n', stderr);
+
+  if (stream) fclose(stream);
+  return 0;
+}
@@ -0,0 +1,14 @@
+// Alien Advance
+// Michael Ebens
+
+// Stand-in for avr-libc's <avr/pgmspace.h> in the host checks, so
+// modules and library code that keep tables in flash compile with cc.
+// Flash is ordinary memory on the host.
+
+#ifndef HOST_PGMSPACE_H_
+#define HOST_PGMSPACE_H_
+
+#define PROGMEM
+#define pgm_read_byte(address) (*(const unsigned char*) (address))
+
+#endif /* HOST_PGMSPACE_H_ */
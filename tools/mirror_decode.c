@@ -0,0 +1,209 @@
+// Alien Advance
+// Michael Ebens
+
+// Host side decoder for the screen mirror stream (see screen_mirror.h).
+//
+// Reads the USB serial stream from a file or tty (stdin by default),
+// passes the debug text through to stderr, draws each mirrored frame
+// in the terminal and optionally records the raw frames to a file
+// (LCD_BUFFER_SIZE bytes per frame, in screen_buffer layout).
+//
+// Only exact frames are recorded (see MIRROR_FRAME_EXACT), so a
+// recording never holds a torn frame, but it isn't every frame either:
+// frames the link couldn't keep up with are counted as skipped, and
+// frames identical to the one before aren't sent at all.
+//
+// usage: mirror_decode [-q] [-r frames.raw] [/dev/ttyACM0]
+//   -q  don't draw frames in the terminal
+//
+// Recorded frames can be turned into images with frame_capture.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../screen_mirror.h"
+
+#define LCD_X 84
+#define LCD_Y 48
+#define LCD_BUFFER_SIZE (LCD_X * (LCD_Y / 8))
+
+static unsigned char screen[LCD_BUFFER_SIZE];
+static unsigned long frames = 0;
+static unsigned long torn_frames = 0;
+static unsigned long skipped_frames = 0;
+static unsigned long bad_packets = 0;
+
+static int pixel(int x, int y)
+{
+  return (screen[(y / 8) * LCD_X + x] >> (y % 8)) & 1;
+}
+
+static void draw_frame(void)
+{
+  // two pixel rows per character cell, cursor homed so frames overwrite
+  fputs("\033[H", stdout);
+
+  for (int y = 0; y < LCD_Y; y += 2)
+  {
+    for (int x = 0; x < LCD_X; x++)
+    {
+      int top = pixel(x, y);
+      int bottom = pixel(x, y + 1);
+      fputs(top ? (bottom ? "█" : "▀") : (bottom ? "▄" : " "), stdout);
+    }
+
+    fputc('\n', stdout);
+  }
+
+  printf("frame %lu\n", frames);
+  fflush(stdout);
+}
+
+// returns 0 if the packet is malformed, frame_op is the packet's
+// MIRROR_OP_FRAME op or -1
+static int apply_packet(const unsigned char* data, unsigned int length, int* frame_op)
+{
+  if (length < 2) return 0;
+
+  unsigned int i = data[0] | (data[1] << 8);
+  unsigned int p = 2;
+  *frame_op = -1;
+
+  while (p < length)
+  {
+    unsigned char op = data[p++];
+    unsigned int n = (op & ~MIRROR_OP_TYPE) + 1;
+
+    switch (op & MIRROR_OP_TYPE)
+    {
+      case MIRROR_OP_SKIP:
+        i += n;
+        break;
+
+      case MIRROR_OP_RUN:
+        if (p >= length || i + n > LCD_BUFFER_SIZE) return 0;
+        memset(&screen[i], data[p++], n);
+        i += n;
+        break;
+
+      case MIRROR_OP_LITERAL:
+        if (p + n > length || i + n > LCD_BUFFER_SIZE) return 0;
+        memcpy(&screen[i], &data[p], n);
+        p += n;
+        i += n;
+        break;
+
+      case MIRROR_OP_FRAME:
+        *frame_op = op;
+        i = 0;
+        break;
+    }
+
+    if (i > LCD_BUFFER_SIZE) return 0;
+  }
+
+  return 1;
+}
+
+int main(int argc, char** argv)
+{
+  int quiet = 0;
+  const char* record_path = NULL;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "qr:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'q':
+        quiet = 1;
+        break;
+
+      case 'r':
+        record_path = optarg;
+        break;
+
+      default:
+        fprintf(stderr, "usage: %s [-q] [-r frames.raw] [tty]\n", argv[0]);
+        return 1;
+    }
+  }
+
+  FILE* in = stdin;
+
+  if (optind < argc && !(in = fopen(argv[optind], "rb")))
+  {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  FILE* record = NULL;
+
+  if (record_path && !(record = fopen(record_path, "wb")))
+  {
+    perror(record_path);
+    return 1;
+  }
+
+  if (!quiet) fputs("\033[2J", stdout);
+
+  unsigned char packet[0x10000];
+  int c;
+
+  while ((c = fgetc(in)) != EOF)
+  {
+    if (c != MIRROR_MAGIC0)
+    {
+      fputc(c, stderr);
+      continue;
+    }
+
+    if ((c = fgetc(in)) != MIRROR_MAGIC1)
+    {
+      // not a packet after all
+      fputc(MIRROR_MAGIC0, stderr);
+      if (c == EOF) break;
+      fputc(c, stderr);
+      continue;
+    }
+
+    int lo = fgetc(in);
+    int hi = fgetc(in);
+    if (hi == EOF) break;
+
+    unsigned int length = lo | (hi << 8);
+    if (fread(packet, 1, length, in) != length) break;
+
+    int frame_op;
+
+    if (!apply_packet(packet, length, &frame_op))
+    {
+      bad_packets++;
+      continue;
+    }
+
+    if (frame_op != -1)
+    {
+      frames++;
+
+      if (frame_op & MIRROR_FRAME_EXACT)
+      {
+        skipped_frames += frame_op & MIRROR_MAX_SKIPPED;
+        if (record) fwrite(screen, 1, LCD_BUFFER_SIZE, record);
+      }
+      else
+      {
+        torn_frames++;
+      }
+
+      if (!quiet) draw_frame();
+    }
+  }
+
+  fprintf(stderr, "%lu frames (%lu torn, not recorded), %lu skipped, %lu bad packets\n",
+    frames, torn_frames, skipped_frames, bad_packets);
+  if (record) fclose(record);
+  return 0;
+}
@@ -0,0 +1,81 @@
+#!/bin/sh
+# Alien Advance
+# Michael Ebens
+
+# Breaks the flash and RAM use of the linked ELF down by symbol and by
+# module, and diffs it against a stored baseline report.
+#
+# usage: size_report.sh elf baseline report module=object_or_archive...
+#
+# Every symbol in the ELF (avr-nm --size-sort) is attributed to the first
+# module whose object or archive defines it, so list the game's own
+# objects first and libc last (libm overrides some libc routines).
+# Symbols nobody claims, e.g. the vector table, are put under "other".
+#
+# The full per-symbol report is written to report. Copy it over the
+# baseline (make size-baseline) to accept the current footprint.
+
+elf=$1
+baseline=$2
+report=$3
+shift 3
+
+NM=${NM:-avr-nm}
+owners=$(mktemp)
+trap 'rm -f "$owners"' EXIT
+
+# name -> module, for every symbol each module defines
+for arg in "$@"
+do
+  module=${arg%%=*}
+  path=${arg#*=}
+  $NM --defined-only "$path" 2>/dev/null | awk -v module="$module" 'NF == 3 { print $3, module }'
+done > "$owners"
+
+# flash holds code, progmem and the initial values of .data; RAM holds
+# .data and .bss
+$NM --size-sort -S "$elf" | awk -v owners="$owners" '
+  BEGIN { while ((getline line < owners) > 0) { split(line, f, " "); if (!(f[1] in owner)) owner[f[1]] = f[2] } }
+  function hex(s,  n, i) { n = 0; for (i = 1; i <= length(s); i++) n = n * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1; return n }
+  NF == 4 {
+    size = hex($2); type = toupper($3); name = $4
+    module = (name in owner) ? owner[name] : "other"
+    flash = (type == "T" || type == "W" || type == "V" || type == "D" || type == "R" || type == "G") ? size : 0
+    ram = (type == "D" || type == "R" || type == "G" || type == "B" || type == "S") ? size : 0
+    if (flash || ram) print module, flash, ram, name
+  }' > "$report"
+
+avr-size --mcu=atmega32u4 -C "$elf"
+
+# a missing baseline diffs as empty, so everything shows as added
+awk -v baseline="$baseline" '
+  BEGIN {
+    while ((getline < baseline) > 0)
+    {
+      base_flash[$1] += $2; base_ram[$1] += $3; base_sym[$1 " " $4] = $2 " " $3; modules[$1]
+    }
+  }
+  { flash[$1] += $2; ram[$1] += $3; sym[$1 " " $4] = $2 " " $3; modules[$1] }
+  END {
+    printf "%-16s %7s %7s %7s %7s\n", "module", "flash", "+/-", "ram", "+/-"
+    fflush()
+    for (m in modules)
+    {
+      printf "%-16s %7d %+7d %7d %+7d\n", m, flash[m], flash[m] - base_flash[m], ram[m], ram[m] - base_ram[m] | "sort -k2 -nr"
+      total_flash += flash[m]; total_ram += ram[m]
+      total_base_flash += base_flash[m]; total_base_ram += base_ram[m]
+    }
+    close("sort -k2 -nr")
+    printf "%-16s %7d %+7d %7d %+7d\n", "total", total_flash, total_flash - total_base_flash, total_ram, total_ram - total_base_ram
+
+    # symbols that appeared, went away or changed size since the baseline
+    for (s in base_sym) if (!(s in sym)) sym[s] = "0 0"
+    for (s in sym)
+    {
+      if (!(s in base_sym)) base_sym[s] = "0 0"
+      if (sym[s] == base_sym[s]) continue
+      split(sym[s], now, " "); split(base_sym[s], was, " ")
+      if (!header++) print "\nchanged symbols (module name flash ram):"
+      printf "  %s %+d %+d\n", s, now[1] - was[1], now[2] - was[2]
+    }
+  }' "$report"
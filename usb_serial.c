@@ -29,9 +29,12 @@
 // Version 1.5: add support for Teensy 2.0
 // Version 1.6: fix zero length packet bug
 // Version 1.7: fix usb_serial_set_control
+// Alien Advance: added zero-copy transmit ring, drained at start of frame
+// Alien Advance: added usb_serial_read
 
 #define USB_SERIAL_PRIVATE_INCLUDE
 #include "usb_serial.h"
+#include "config.h"
 
 
 /**************************************************************************
@@ -93,6 +96,10 @@
 // operating systems.
 #define SUPPORT_ENDPOINT_HALT
 
+// The size of the transmit ring filled by usb_serial_tx_reserve/commit
+// and drained into the CDC IN endpoint by the start of frame interrupt
+// is TX_RING_SIZE in config.h.
+
 
 
 /**************************************************************************
@@ -306,6 +313,15 @@ static uint8_t transmit_previous_timeout=0;
 static uint8_t cdc_line_coding[7]={0x00, 0xE1, 0x00, 0x00, 0x00, 0x00, 0x08};
 static uint8_t cdc_line_rtsdtr=0;
 
+// transmit ring.  The head is only written by the main program and
+// the tail only by the start of frame interrupt, so neither side
+// needs to disable interrupts to touch its own index.
+static uint8_t tx_ring[TX_RING_SIZE];
+static volatile uint8_t tx_ring_head=0;
+static volatile uint8_t tx_ring_tail=0;
+static uint8_t tx_ring_age=0;
+static volatile uint32_t tx_ring_sent=0;
+
 
 /**************************************************************************
  *
@@ -369,6 +385,43 @@ int16_t usb_serial_getchar(void)
 	return c;
 }
 
+// receive up to size bytes without waiting.  Returns the number
+// of bytes read, 0 if nothing has been received.  The endpoint is
+// selected once and whole banks are copied out, which is much
+// cheaper than calling usb_serial_getchar for each byte.
+uint8_t usb_serial_read(uint8_t *buffer, uint8_t size)
+{
+	uint8_t c, n, count=0, intr_state;
+
+	intr_state = SREG;
+	cli();
+	if (!usb_configuration) {
+		SREG = intr_state;
+		return 0;
+	}
+	UENUM = CDC_RX_ENDPOINT;
+	while (count < size) {
+		c = UEINTX;
+		if (!(c & (1<<RWAL))) {
+			// no data in this bank, release it if
+			// it was an empty packet and try the next
+			if (c & (1<<RXOUTI)) {
+				UEINTX = 0x6B;
+				continue;
+			}
+			break;
+		}
+		n = UEBCLX;
+		if (n > size - count) n = size - count;
+		count += n;
+		for (; n; n--) *buffer++ = UEDATX;
+		// if buffer completely used, release it
+		if (!(UEINTX & (1<<RWAL))) UEINTX = 0x6B;
+	}
+	SREG = intr_state;
+	return count;
+}
+
 // number of bytes available in the receive buffer
 uint8_t usb_serial_available(void)
 {
@@ -639,6 +692,87 @@ void usb_serial_flush_output(void)
 	SREG = intr_state;
 }
 
+// reserve space in the transmit ring to be filled in place.
+// Returns a pointer to the free space, with *size reduced to the
+// number of contiguous bytes available (possibly 0).  The space is
+// not sent until usb_serial_tx_commit() is called.
+// Data written this way is not ordered with respect to data sent
+// by usb_serial_putchar/usb_serial_write, so don't mix the two.
+uint8_t * usb_serial_tx_reserve(uint8_t *size)
+{
+	uint8_t head, used, contiguous;
+
+	head = tx_ring_head;
+	used = head - tx_ring_tail;
+	contiguous = TX_RING_SIZE - (head & (TX_RING_SIZE - 1));
+	if (contiguous > TX_RING_SIZE - used) contiguous = TX_RING_SIZE - used;
+	if (*size > contiguous) *size = contiguous;
+	return tx_ring + (head & (TX_RING_SIZE - 1));
+}
+
+// queue bytes previously written into reserved space
+void usb_serial_tx_commit(uint8_t size)
+{
+	// make sure the data lands before the interrupt can see it
+	__asm__ __volatile__ ("" ::: "memory");
+	tx_ring_head += size;
+}
+
+// number of bytes free in the transmit ring
+uint8_t usb_serial_tx_free(void)
+{
+	return TX_RING_SIZE - (uint8_t)(tx_ring_head - tx_ring_tail);
+}
+
+// copy a buffer into the transmit ring, never waiting.
+// Returns the number of bytes queued, which is less than size
+// if the ring is full (eg, nobody is listening on the PC).
+uint16_t usb_serial_tx_write(const uint8_t *buffer, uint16_t size)
+{
+	uint16_t queued = 0;
+	uint8_t n, i, *p;
+
+	while (queued < size) {
+		n = (size - queued > 255) ? 255 : size - queued;
+		p = usb_serial_tx_reserve(&n);
+		if (!n) break;
+		queued += n;
+		for (i = n; i; i--) *p++ = *buffer++;
+		usb_serial_tx_commit(n);
+	}
+	return queued;
+}
+
+// the same, copying from program memory (eg, a PSTR string)
+uint16_t usb_serial_tx_write_P(const uint8_t *buffer, uint16_t size)
+{
+	uint16_t queued = 0;
+	uint8_t n, i, *p;
+
+	while (queued < size) {
+		n = (size - queued > 255) ? 255 : size - queued;
+		p = usb_serial_tx_reserve(&n);
+		if (!n) break;
+		queued += n;
+		for (i = n; i; i--) *p++ = pgm_read_byte(buffer++);
+		usb_serial_tx_commit(n);
+	}
+	return queued;
+}
+
+// total number of bytes moved from the ring to the endpoint
+uint32_t usb_serial_tx_sent(void)
+{
+	uint8_t intr_state;
+	uint32_t sent;
+
+	intr_state = SREG;
+	cli();
+	sent = tx_ring_sent;
+	SREG = intr_state;
+	return sent;
+}
+
 // functions to read the various async serial settings.  These
 // aren't actually used by USB at all (communication is always
 // at full USB speed), but they are set by the host so we can
@@ -713,6 +847,39 @@ int8_t usb_serial_set_control(uint8_t signals)
  **************************************************************************/
 
 
+// Move queued bytes from the transmit ring into the CDC IN endpoint.
+// Only whole packets are sent, unless data has been waiting for
+// TRANSMIT_FLUSH_TIMEOUT frames, then the remainder goes out too.
+static inline void tx_ring_drain(void)
+{
+	uint8_t tail, used, n;
+
+	tail = tx_ring_tail;
+	used = tx_ring_head - tail;
+	if (!used) {
+		tx_ring_age = 0;
+		return;
+	}
+	if (tx_ring_age < TRANSMIT_FLUSH_TIMEOUT) tx_ring_age++;
+	UENUM = CDC_TX_ENDPOINT;
+	while (used && (UEINTX & (1<<RWAL))) {
+		n = CDC_TX_SIZE - UEBCLX;
+		if (n > used) {
+			if (tx_ring_age < TRANSMIT_FLUSH_TIMEOUT) break;
+			n = used;
+		}
+		used -= n;
+		tx_ring_sent += n;
+		for (; n; n--) {
+			UEDATX = tx_ring[tail++ & (TX_RING_SIZE - 1)];
+		}
+		UEINTX = 0x3A;
+		tx_ring_age = 0;
+	}
+	tx_ring_tail = tail;
+}
+
+
 // USB Device Interrupt - handle all device-level events
 // the transmit buffer flushing is triggered by the start of frame
 //
@@ -733,6 +900,7 @@ ISR(USB_GEN_vect)
         }
 	if (intbits & (1<<SOFI)) {
 		if (usb_configuration) {
+			tx_ring_drain();
 			t = transmit_flush_timer;
 			if (t) {
 				transmit_flush_timer = --t;
@@ -850,6 +1018,7 @@ ISR(USB_COM_vect)
 			usb_configuration = wValue;
 			cdc_line_rtsdtr = 0;
 			transmit_flush_timer = 0;
+			tx_ring_tail = tx_ring_head;
 			usb_send_in();
 			cfg = endpoint_config_table;
 			for (i=1; i<5; i++) {
@@ -9,6 +9,7 @@ uint8_t usb_configured(void);		// is the USB port configured
 
 // receiving data
 int16_t usb_serial_getchar(void);	// receive a character (-1 if timeout/error)
+uint8_t usb_serial_read(uint8_t *buffer, uint8_t size); // receive a buffer, do not wait
 uint8_t usb_serial_available(void);	// number of bytes in receive buffer
 void usb_serial_flush_input(void);	// discard any buffered input
 
@@ -18,6 +19,14 @@ int8_t usb_serial_putchar_nowait(uint8_t c);  // transmit a character, do not wa
 int8_t usb_serial_write(const uint8_t *buffer, uint16_t size); // transmit a buffer
 void usb_serial_flush_output(void);	// immediately transmit any buffered output
 
+// zero-copy transmitting, drained by the start of frame interrupt
+uint8_t *usb_serial_tx_reserve(uint8_t *size); // get contiguous free space
+void usb_serial_tx_commit(uint8_t size);	// queue filled reserved space
+uint8_t usb_serial_tx_free(void);	// number of free bytes in the ring
+uint16_t usb_serial_tx_write(const uint8_t *buffer, uint16_t size); // queue a copy, do not wait
+uint16_t usb_serial_tx_write_P(const uint8_t *buffer, uint16_t size); // same, from program memory
+uint32_t usb_serial_tx_sent(void);	// total bytes drained from the ring
+
 // serial parameters
 uint32_t usb_serial_get_baud(void);	// get the baud rate
 uint8_t usb_serial_get_stopbits(void);	// get the number of stop bits